@@ -0,0 +1,125 @@
+//
+//  benchmark.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Timing and CSV output shared by the solver and interpolation benchmarks.
+//
+
+#ifndef benchmark_h
+#define benchmark_h
+
+// clock_gettime NEEDS POSIX.1b. THIS ONLY TAKES EFFECT IF NO SYSTEM HEADER CAME FIRST, SO THE
+// BENCHMARKS ALSO DEFINE IT AT THEIR TOP
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include "solver.h"
+
+// EVERY CASE IS REPEATED UNTIL AT LEAST THIS LONG HAS ELAPSED (OVERRIDDEN BY argv[1])
+#define BENCHMARK_MIN_SECONDS 0.05
+
+// WHAT ONE RUN OF A CASE ACHIEVED: error IS |x - root| WHEN THE ROOT IS KNOWN, ||F(x)|| FOR
+// SYSTEMS, OR THE LARGEST INTERPOLATION ERROR OVER THE QUERY SET
+struct BenchmarkResult {
+  unsigned long evaluations;
+  unsigned int iterations;
+  double error;
+  enum SolverTermination termination;
+};
+
+typedef void (*benchmark_case)(void* context, struct BenchmarkResult* result);
+
+static inline double benchmark_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static inline double benchmark_min_seconds(const int argc, char** argv) {
+  return (argc > 1) ? atof(argv[1]) : BENCHMARK_MIN_SECONDS;
+}
+
+// MEAN WALL TIME OF ONE RUN, WITH result TAKEN FROM THE LAST RUN
+static inline double benchmark_time(const benchmark_case run, void* context, struct BenchmarkResult* result, const double minSeconds) {
+  unsigned long reps = 0;
+  const double start = benchmark_now();
+  double elapsed = 0;
+  do {
+    run(context, result);
+    reps++;
+    elapsed = benchmark_now() - start;
+  } while (elapsed < minSeconds);
+  return elapsed / reps;
+}
+
+static inline const char* benchmark_termination_name(const enum SolverTermination termination) {
+  switch (termination) {
+    case SOLVER_RUNNING:
+      return "running";
+    case SOLVER_CONVERGED:
+      return "converged";
+    case SOLVER_MAX_ITERATIONS:
+      return "max_iterations";
+    case SOLVER_INVALID_ARGUMENT:
+      return "invalid_argument";
+    case SOLVER_OUT_OF_RANGE:
+      return "out_of_range";
+    case SOLVER_DIVISION_BY_ZERO:
+      return "division_by_zero";
+    case SOLVER_INVALID_BRACKET:
+      return "invalid_bracket";
+    case SOLVER_SINGULAR_JACOBIAN:
+      return "singular_jacobian";
+  }
+  return "unknown";
+}
+
+static inline void benchmark_header(void) {
+  printf("suite,method,problem,size,degree,seconds,evaluations,iterations,error,termination\n");
+  fflush(stdout);
+}
+
+// ONE CSV ROW PER CASE, WITH termination AS THE LAST COLUMN. SOLVER MESSAGES GO TO stderr,
+// SO stdout STAYS MACHINE-READABLE
+static inline void benchmark_row_as(const char* suite, const char* method, const char* problem, const unsigned long size, const unsigned int degree, const double seconds, const struct BenchmarkResult* result, const char* termination) {
+  printf("%s,%s,%s,%lu,%u,%.6e,%lu,%u,%.6e,%s\n", suite, method, problem, size, degree, seconds, result->evaluations, result->iterations, result->error, termination);
+  fflush(stdout);
+}
+
+static inline void benchmark_row(const char* suite, const char* method, const char* problem, const unsigned long size, const unsigned int degree, const double seconds, const struct BenchmarkResult* result) {
+  benchmark_row_as(suite, method, problem, size, degree, seconds, result, benchmark_termination_name(result->termination));
+}
+
+// FOR CASES WITH A KNOWN ANSWER: A STOPPING RULE THAT ONLY LOOKS AT THE STEP CAN REPORT
+// CONVERGENCE FAR FROM THE ROOT, SO SUCH A ROW IS WRITTEN AS false_convergence INSTEAD OF
+// converged AND REPORTED ON stderr. RETURNS true WHEN THE ROW WAS FLAGGED
+static inline bool benchmark_row_checked(const char* suite, const char* method, const char* problem, const unsigned long size, const unsigned int degree, const double seconds, const struct BenchmarkResult* result, const double tolerance) {
+  const bool falseConvergence = result->termination == SOLVER_CONVERGED && !(result->error <= tolerance);
+  if (!falseConvergence) {
+    benchmark_row(suite, method, problem, size, degree, seconds, result);
+    return false;
+  }
+  benchmark_row_as(suite, method, problem, size, degree, seconds, result, "false_convergence");
+  fprintf(stderr, "FALSE CONVERGENCE: %s on %s (size %lu) reported convergence %.3e from the known answer\n", method, problem, size, result->error);
+  return true;
+}
+
+// FOR CASES THAT MUST CONVERGE: REPORTS ANY OTHER TERMINATION ON stderr SO A REGRESSION CANNOT
+// HIDE IN THE CSV. RETURNS false ON FAILURE, FOR THE BENCHMARK'S EXIT STATUS
+static inline bool benchmark_expect_converged(const char* method, const char* problem, const unsigned long size, const struct BenchmarkResult* result) {
+  if (result->termination == SOLVER_CONVERGED)
+    return true;
+  fprintf(stderr, "FAILED: %s on %s (size %lu) stopped with %s\n", method, problem, size, benchmark_termination_name(result->termination));
+  return false;
+}
+
+#endif /* benchmark_h */
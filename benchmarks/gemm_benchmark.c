@@ -0,0 +1,159 @@
+//
+//  gemm_benchmark.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Compares matrix_gemm against the original inner-product matrix_product, after checking
+//  threaded products whose row count is not a multiple of the slice size. Exits with status 1
+//  if any check fails.
+//  Build: cc -O3 -march=native -I../source gemm_benchmark.c ../source/*.c -lm -lpthread
+//
+
+// clock_gettime AND CLOCK_MONOTONIC ARE POSIX, NOT ISO C: NEEDED UNDER -std=c11
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include "definitions.h"
+#include "matrixkernels.h"
+
+// THE REFERENCE IS O(n^3) WITH A POOR ACCESS PATTERN, SO IT IS ONLY TIMED UP TO THIS SIZE
+#define REFERENCE_MAX_SIZE 1024
+#define MIN_SECONDS 0.2
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+// PREVIOUS matrix_product: ONE inner_product PER ENTRY AGAINST A TRANSPOSED COPY OF m2,
+// PLUS THE TRANSPOSE OF THE RESULT, ALLOCATED ON EVERY CALL
+static void reference_product(const struct Matrix* m1, const struct Matrix* m2, struct Matrix* ptr) {
+  const unsigned int n = m1->nrows, k = m1->ncols, m = m2->ncols;
+  double** transpose = malloc(m * sizeof(double*));
+  for (unsigned int j = 0; j < m; j++) {
+    transpose[j] = malloc(k * sizeof(double));
+    for (unsigned int p = 0; p < k; p++)
+      transpose[j][p] = *matrix_element(m2, p, j);
+  }
+  for (unsigned int i = 0; i < n; i++)
+    for (unsigned int j = 0; j < m; j++)
+      *matrix_element(ptr, i, j) = inner_product(matrix_element(m1, i, 0), transpose[j], k);
+  double** resultTranspose = malloc(m * sizeof(double*));
+  for (unsigned int j = 0; j < m; j++) {
+    resultTranspose[j] = malloc(n * sizeof(double));
+    for (unsigned int i = 0; i < n; i++)
+      resultTranspose[j][i] = *matrix_element(ptr, i, j);
+  }
+  for (unsigned int j = 0; j < m; j++) {
+    free(transpose[j]);
+    free(resultTranspose[j]);
+  }
+  free(transpose);
+  free(resultTranspose);
+}
+
+// (rows, inner, columns) LARGE ENOUGH TO BE THREADED, WITH ROW COUNTS THAT DO NOT DIVIDE
+// EVENLY INTO GEMM_MR-ROW SLICES AND INNER / COLUMN SIZES THAT CROSS THE KC AND NC BLOCKS
+static const unsigned int checkShapes[][3] = { { 17, 512, 512 }, { 257, 256, 256 }, { 61, 300, 520 }, { 130, 129, 257 } };
+static const unsigned int checkThreads[] = { 2, 3, 4, 8 };
+
+// matrix_gemm (alpha = 1.5, beta = 0.5) AGAINST A TRIPLE LOOP, FOR EVERY SHAPE AND THREAD COUNT
+static bool check_threaded_gemm(void) {
+  bool passed = true;
+  const unsigned int defaultThreads = get_matrix_threads();
+  for (size_t s = 0; s < sizeof(checkShapes) / sizeof(checkShapes[0]); s++) {
+    const unsigned int m = checkShapes[s][0], k = checkShapes[s][1], n = checkShapes[s][2];
+    struct Matrix* A = new_matrix(m, k);
+    struct Matrix* B = new_matrix(k, n);
+    struct Matrix* C = new_matrix(m, n);
+    for (unsigned int i = 0; i < m; i++)
+      for (unsigned int p = 0; p < k; p++)
+        *matrix_element(A, i, p) = sin(i + 2.0 * p);
+    for (unsigned int p = 0; p < k; p++)
+      for (unsigned int j = 0; j < n; j++)
+        *matrix_element(B, p, j) = cos(3.0 * p - j);
+    for (size_t t = 0; t < sizeof(checkThreads) / sizeof(checkThreads[0]); t++) {
+      set_matrix_threads(checkThreads[t]);
+      for (unsigned int i = 0; i < m; i++)
+        for (unsigned int j = 0; j < n; j++)
+          *matrix_element(C, i, j) = i - 0.5 * j;
+      matrix_gemm(1.5, A, B, 0.5, C);
+      double error = 0;
+      for (unsigned int i = 0; i < m; i++) {
+        for (unsigned int j = 0; j < n; j++) {
+          double dot = 0;
+          for (unsigned int p = 0; p < k; p++)
+            dot += *matrix_element(A, i, p) * *matrix_element(B, p, j);
+          error = fmax(error, fabs(*matrix_element(C, i, j) - (1.5 * dot + 0.5 * (i - 0.5 * j))));
+        }
+      }
+      if (!(error <= 1e-12 * k)) {
+        fprintf(stderr, "FAILED: matrix_gemm %ux%u * %ux%u on %u threads is off by %.3e\n", m, k, k, n, checkThreads[t], error);
+        passed = false;
+      }
+    }
+    destroy_matrix(A);
+    destroy_matrix(B);
+    destroy_matrix(C);
+  }
+  set_matrix_threads(defaultThreads);
+  return passed;
+}
+
+static double gflops(const unsigned int n, const unsigned int reps, const double seconds) {
+  return 2.0 * n * n * (double) n * reps / seconds * 1e-9;
+}
+
+int main(void) {
+  const bool passed = check_threaded_gemm();
+  printf("%6s %14s %14s %10s %12s\n", "n", "reference", "matrix_gemm", "speedup", "max error");
+  for (unsigned int n = 8; n <= 4096; n *= 2) {
+    struct Matrix* A = new_matrix(n, n);
+    struct Matrix* B = new_matrix(n, n);
+    struct Matrix* C = new_matrix(n, n);
+    struct Matrix* R = new_matrix(n, n);
+    for (unsigned int i = 0; i < n; i++) {
+      for (unsigned int j = 0; j < n; j++) {
+        *matrix_element(A, i, j) = sin(i + 2.0 * j);
+        *matrix_element(B, i, j) = cos(3.0 * i - j);
+      }
+    }
+    unsigned int reps = 0;
+    double start = now(), elapsed = 0;
+    do {
+      matrix_gemm(1.0, A, B, 0.0, C);
+      reps++;
+      elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    const double fast = gflops(n, reps, elapsed);
+    if (n <= REFERENCE_MAX_SIZE) {
+      reps = 0;
+      start = now();
+      do {
+        reference_product(A, B, R);
+        reps++;
+        elapsed = now() - start;
+      } while (elapsed < MIN_SECONDS);
+      const double slow = gflops(n, reps, elapsed);
+      double error = 0;
+      for (unsigned int i = 0; i < n; i++)
+        for (unsigned int j = 0; j < n; j++)
+          error = fmax(error, fabs(*matrix_element(C, i, j) - *matrix_element(R, i, j)));
+      printf("%6u %9.2f GF/s %9.2f GF/s %9.2fx %12.3e\n", n, slow, fast, fast / slow, error);
+    } else {
+      printf("%6u %14s %9.2f GF/s %10s %12s\n", n, "-", fast, "-", "-");
+    }
+    destroy_matrix(A);
+    destroy_matrix(B);
+    destroy_matrix(C);
+    destroy_matrix(R);
+  }
+  return passed ? 0 : 1;
+}
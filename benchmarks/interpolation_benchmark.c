@@ -0,0 +1,285 @@
+//
+//  interpolation_benchmark.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Times every interpolation routine at growing node counts and degrees and prints one
+//  CSV row per case (seconds is the mean time of one evaluation).
+//  Build: cc -O3 -march=native -I../source interpolation_benchmark.c ../source/*.c -lm -lpthread
+//  Usage: ./a.out [minimum seconds per case] > interpolation.csv
+//
+
+// clock_gettime AND CLOCK_MONOTONIC ARE POSIX, NOT ISO C: NEEDED UNDER -std=c11
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "definitions.h"
+#include "interpolation.h"
+#include "scalar.h"
+
+#define QUERIES 256
+#define GLOBAL_MAX_NODES 128
+#define LOCAL_MAX_NODES 100000
+#define LOCAL_MAX_DEGREE 8
+#define INTERVAL_LENGTH 10.0
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// SMOOTH TEST FUNCTION FOR EVERY FAMILY
+static double target(const double x) {
+  return sin(3 * x) + exp(-x * x);
+}
+
+// GLOBAL INTERPOLANTS THROUGH n CHEBYSHEV NODES ON [-1, 1]
+
+enum GlobalMethod {
+  LAGRANGE,
+  AITKEN,
+  BARYCENTRIC,
+  BARYCENTRIC_BATCH,
+  GLOBAL_METHODS
+};
+
+static const char* globalNames[GLOBAL_METHODS] = { "lagrange", "aitken", "barycentric", "barycentric_batch" };
+
+struct GlobalCase {
+  enum GlobalMethod method;
+  unsigned int npoints;
+  const double* xval;
+  const double* fval;
+  const struct BarycentricInterpolant* interpolant;
+  const double* queries;
+  double* output;
+};
+
+static void run_global_case(void* ptr, struct BenchmarkResult* result) {
+  const struct GlobalCase* c = ptr;
+  switch (c->method) {
+    case LAGRANGE:
+      for (unsigned int q = 0; q < QUERIES; q++)
+        c->output[q] = lagrange(c->queries[q], c->xval, c->fval, c->npoints);
+      break;
+    case AITKEN:
+      for (unsigned int q = 0; q < QUERIES; q++)
+        c->output[q] = aitken(c->queries[q], c->xval, c->fval, c->npoints);
+      break;
+    case BARYCENTRIC:
+      for (unsigned int q = 0; q < QUERIES; q++)
+        c->output[q] = barycentric(c->interpolant, c->queries[q]);
+      break;
+    case BARYCENTRIC_BATCH:
+      barycentric_batch(c->interpolant, c->queries, c->output, QUERIES);
+      break;
+    case GLOBAL_METHODS:
+      break;
+  }
+  result->evaluations = QUERIES;
+  result->iterations = 0;
+  result->error = 0;
+  for (unsigned int q = 0; q < QUERIES; q++)
+    result->error = fmax(result->error, fabs(c->output[q] - target(c->queries[q])));
+  result->termination = SOLVER_CONVERGED;
+}
+
+// LOCAL FINITE-DIFFERENCE FORMULAS ON A UNIFORM TABLE OF n NODES OVER [0, INTERVAL_LENGTH]
+// THE SINGLE-BASE FORMULAS ARE QUERIED INSIDE THE INTERVAL OF THEIR BASE NODE; THE
+// PIECEWISE ENGINE IS QUERIED ACROSS THE WHOLE TABLE
+
+enum LocalMethod {
+  NEWTON_ASCENDING_TABLE,
+  NEWTON_ASCENDING_REBUILD,
+  NEWTON_DESCENDING_TABLE,
+  NEWTON_DESCENDING_REBUILD,
+  STIRLING_TABLE,
+  STIRLING_REBUILD,
+  EVERETT_TABLE,
+  EVERETT_REBUILD,
+  PLAN,
+  PLAN_BATCH,
+  PLAN_BATCH_FLOAT,
+  PIECEWISE,
+  PIECEWISE_SORTED,
+  LOCAL_METHODS
+};
+
+static const char* localNames[LOCAL_METHODS] = { "newton_ascending", "newton_ascending2", "newton_descending", "newton_descending2", "stirling", "stirling2", "everett", "everett2", "interpolation_plan_eval", "interpolation_plan_batch", "interpolation_plan_batch_f", "piecewise_interpolate", "piecewise_interpolate_sorted" };
+
+struct LocalCase {
+  enum LocalMethod method;
+  unsigned int npoints;
+  unsigned int degree;
+  double h;
+  const double* xval;
+  const double* fval;
+  const struct DifferenceTable* table;
+  const struct InterpolationPlan* plan;
+  const struct InterpolationPlan_f* floatPlan;
+  const struct PiecewiseInterpolator* piecewise;
+  unsigned int index;
+  double* queries;
+  double* output;
+  float* floatQueries;
+  float* floatOutput;
+};
+
+// BASE NODE AND QUERY SPAN OF EACH SINGLE-BASE METHOD
+static void local_queries(struct LocalCase* c) {
+  const unsigned int n = c->npoints;
+  unsigned int index = n / 2;
+  double offset = 0, span = c->h;
+  switch (c->method) {
+    case NEWTON_ASCENDING_TABLE:
+    case NEWTON_ASCENDING_REBUILD:
+      index = 0;
+      break;
+    case NEWTON_DESCENDING_TABLE:
+    case NEWTON_DESCENDING_REBUILD:
+      index = n - 1;
+      offset = -c->h;
+      break;
+    case STIRLING_TABLE:
+    case STIRLING_REBUILD:
+      offset = -c->h / 2;
+      break;
+    case PIECEWISE:
+    case PIECEWISE_SORTED:
+      index = 0;
+      span = INTERVAL_LENGTH;
+      break;
+    default:
+      break;
+  }
+  c->index = index;
+  for (unsigned int q = 0; q < QUERIES; q++)
+    c->queries[q] = c->xval[index] + offset + span * (q + 0.5) / QUERIES;
+}
+
+static void run_local_case(void* ptr, struct BenchmarkResult* result) {
+  const struct LocalCase* c = ptr;
+  const unsigned int n = c->npoints, d = c->degree, i = c->index;
+  for (unsigned int q = 0; q < QUERIES; q++) {
+    const double x = c->queries[q];
+    switch (c->method) {
+      case NEWTON_ASCENDING_TABLE:
+        c->output[q] = newton_ascending(c->table, x, c->xval, c->fval, d, c->h, n);
+        break;
+      case NEWTON_ASCENDING_REBUILD:
+        c->output[q] = newton_ascending2(x, c->xval, c->fval, d, c->h, n);
+        break;
+      case NEWTON_DESCENDING_TABLE:
+        c->output[q] = newton_descending(c->table, x, i, c->xval, c->fval, d, c->h, n);
+        break;
+      case NEWTON_DESCENDING_REBUILD:
+        c->output[q] = newton_descending2(x, i, c->xval, c->fval, d, c->h, n);
+        break;
+      case STIRLING_TABLE:
+        c->output[q] = stirling(c->table, x, i, c->xval, c->fval, d, c->h, n);
+        break;
+      case STIRLING_REBUILD:
+        c->output[q] = stirling2(x, i, c->xval, c->fval, d, c->h, n);
+        break;
+      case EVERETT_TABLE:
+        c->output[q] = everett(c->table, x, i, c->xval, c->fval, d, c->h, n);
+        break;
+      case EVERETT_REBUILD:
+        c->output[q] = everett2(x, i, c->xval, c->fval, d, c->h, n);
+        break;
+      case PLAN:
+        c->output[q] = interpolation_plan_eval(c->plan, x);
+        break;
+      case PIECEWISE:
+        c->output[q] = piecewise_interpolate(c->piecewise, x);
+        break;
+      default:
+        break;
+    }
+  }
+  if (c->method == PLAN_BATCH)
+    interpolation_plan_batch(c->plan, c->queries, c->output, QUERIES);
+  else if (c->method == PLAN_BATCH_FLOAT) {
+    interpolation_plan_batch_f(c->floatPlan, c->floatQueries, c->floatOutput, QUERIES);
+    for (unsigned int q = 0; q < QUERIES; q++)
+      c->output[q] = c->floatOutput[q];
+  } else if (c->method == PIECEWISE_SORTED)
+    piecewise_interpolate_sorted(c->piecewise, c->queries, c->output, QUERIES);
+  result->evaluations = QUERIES;
+  result->iterations = 0;
+  result->error = 0;
+  for (unsigned int q = 0; q < QUERIES; q++)
+    result->error = fmax(result->error, fabs(c->output[q] - target(c->queries[q])));
+  result->termination = SOLVER_CONVERGED;
+}
+
+int main(int argc, char** argv) {
+  const double minSeconds = benchmark_min_seconds(argc, argv);
+  struct BenchmarkResult result;
+  double queries[QUERIES], output[QUERIES];
+  float floatQueries[QUERIES], floatOutput[QUERIES];
+  benchmark_header();
+
+  for (unsigned int n = 4; n <= GLOBAL_MAX_NODES; n *= 2) {
+    double* xval = malloc(n * sizeof(double));
+    double* fval = malloc(n * sizeof(double));
+    for (unsigned int j = 0; j < n; j++) {
+      xval[j] = cos(M_PI * (2 * j + 1) / (2.0 * n));
+      fval[j] = target(xval[j]);
+    }
+    for (unsigned int q = 0; q < QUERIES; q++)
+      queries[q] = -1 + 2 * (q + 0.5) / QUERIES;
+    struct BarycentricInterpolant* interpolant = new_barycentric(xval, fval, n);
+    for (unsigned int m = 0; m < GLOBAL_METHODS; m++) {
+      struct GlobalCase c = { m, n, xval, fval, interpolant, queries, output };
+      const double seconds = benchmark_time(run_global_case, &c, &result, minSeconds);
+      benchmark_row("interpolation", globalNames[m], "chebyshev", n, n - 1, seconds / QUERIES, &result);
+    }
+    destroy_barycentric(interpolant);
+    free(xval);
+    free(fval);
+  }
+
+  for (unsigned int n = 100; n <= LOCAL_MAX_NODES; n *= 10) {
+    const double h = INTERVAL_LENGTH / (n - 1);
+    double* xval = malloc(n * sizeof(double));
+    double* fval = malloc(n * sizeof(double));
+    float* floatXval = malloc(n * sizeof(float));
+    float* floatFval = malloc(n * sizeof(float));
+    for (unsigned int j = 0; j < n; j++) {
+      xval[j] = j * h;
+      fval[j] = target(xval[j]);
+      floatXval[j] = xval[j];
+      floatFval[j] = fval[j];
+    }
+    for (unsigned int d = 2; d <= LOCAL_MAX_DEGREE; d += 2) {
+      struct DifferenceTable* table = new_difference_table_degree(fval, n, d);
+      struct InterpolationPlan* plan = new_interpolation_plan(table, xval, fval, EVERETT, d, n / 2, h);
+      struct DifferenceTable_f* floatTable = new_difference_table_degree_f(floatFval, n, d);
+      struct InterpolationPlan_f* floatPlan = new_interpolation_plan_f(floatTable, floatXval, floatFval, EVERETT, d, n / 2, h);
+      struct PiecewiseInterpolator* piecewise = new_piecewise_interpolator(xval, fval, n, table, STIRLING, d);
+      for (unsigned int m = 0; m < LOCAL_METHODS; m++) {
+        struct LocalCase c = { m, n, d, h, xval, fval, table, plan, floatPlan, piecewise, 0, queries, output, floatQueries, floatOutput };
+        local_queries(&c);
+        for (unsigned int q = 0; q < QUERIES; q++)
+          floatQueries[q] = queries[q];
+        const double seconds = benchmark_time(run_local_case, &c, &result, minSeconds);
+        benchmark_row("interpolation", localNames[m], "uniform", n, d, seconds / QUERIES, &result);
+      }
+      destroy_piecewise_interpolator(piecewise);
+      destroy_interpolation_plan(plan);
+      destroy_interpolation_plan_f(floatPlan);
+      destroy_difference_table_f(floatTable);
+      destroy_difference_table(table);
+    }
+    free(xval);
+    free(fval);
+    free(floatXval);
+    free(floatFval);
+  }
+  return 0;
+}
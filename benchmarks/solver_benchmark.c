@@ -0,0 +1,480 @@
+//
+//  solver_benchmark.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Runs every root finder over fixed problem families and prints one CSV row per case.
+//  The bracketing methods (bisection, false position, Illinois, Anderson-Björck, Brent) all
+//  start from the same bracket [a, b], so their evaluation counts compare directly.
+//  Build: cc -O3 -march=native -I../source solver_benchmark.c ../source/*.c -lm -lpthread
+//  Usage: ./a.out [minimum seconds per case] > solvers.csv (exits with 1 if a case that must
+//  converge did not). Cases with known roots that stop on a small step far from the root are
+//  written with termination false_convergence.
+//
+
+// clock_gettime AND CLOCK_MONOTONIC ARE POSIX, NOT ISO C: NEEDED UNDER -std=c11
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "benchmark.h"
+#include "definitions.h"
+#include "solver.h"
+#include "unisolvers.h"
+#include "multisolvers.h"
+#include "batchsolvers.h"
+#include "polynomial.h"
+#include "dual.h"
+
+#define PRECISION 1e-12
+#define MAX_ITER 1000
+#define KEPLER_ECCENTRICITY 0.9
+// A CASE THAT CONVERGED FURTHER THAN THIS FROM ITS KNOWN ROOT(S) IS A FALSE CONVERGENCE
+// (sqrt(PRECISION): EVEN THE TRIPLE ROOT IS FOUND TO ABOUT 1e-12)
+#define ROOT_TOLERANCE 1e-6
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// UNIVARIATE PROBLEM FAMILIES
+
+static double cubic(const double x) { return x * x * x - 2 * x - 5; }
+static double cubic_prime(const double x) { return 3 * x * x - 2; }
+static double cubic_fixed(const double x) { return cbrt(2 * x + 5); }
+
+static double cosine(const double x) { return cos(x) - x; }
+static double cosine_prime(const double x) { return -sin(x) - 1; }
+static double cosine_fixed(const double x) { return cos(x); }
+
+static double exponential(const double x) { return exp(-x) - x; }
+static double exponential_prime(const double x) { return -exp(-x) - 1; }
+static double exponential_fixed(const double x) { return exp(-x); }
+
+static double kepler(const double x) { return x - KEPLER_ECCENTRICITY * sin(x) - 1; }
+static double kepler_prime(const double x) { return 1 - KEPLER_ECCENTRICITY * cos(x); }
+static double kepler_fixed(const double x) { return 1 + KEPLER_ECCENTRICITY * sin(x); }
+
+// WILKINSON'S POLYNOMIAL (x - 1)(x - 2)...(x - 10): ILL-CONDITIONED ROOTS
+static double wilkinson(const double x) {
+  double product = 1;
+  for (int k = 1; k <= 10; k++)
+    product *= x - k;
+  return product;
+}
+
+static double wilkinson_prime(const double x) {
+  double sum = 0;
+  for (int j = 1; j <= 10; j++) {
+    double product = 1;
+    for (int k = 1; k <= 10; k++) {
+      if (k != j)
+        product *= x - k;
+    }
+    sum += product;
+  }
+  return sum;
+}
+
+// x^10 - 1 ON [0, 1.3]: PLAIN FALSE POSITION KEEPS ONE ENDPOINT FIXED AND CRAWLS
+static double power10(const double x) { return pow(x, 10) - 1; }
+static double power10_prime(const double x) { return 10 * pow(x, 9); }
+
+// TRIPLE ROOT AT 1
+static double triple(const double x) { return (x - 1) * (x - 1) * (x - 1); }
+static double triple_prime(const double x) { return 3 * (x - 1) * (x - 1); }
+
+struct UnivariateProblem {
+  const char* name;
+  univariate_function f;
+  univariate_function fp;
+  univariate_function g;
+  double a;
+  double b;
+  double x0;
+  double root;
+};
+
+static struct UnivariateProblem problems[] = {
+  { "cubic", cubic, cubic_prime, cubic_fixed, 2, 3, 2, 2.0945514815423265 },
+  { "cos", cosine, cosine_prime, cosine_fixed, 0, 1, 0.5, 0.7390851332151607 },
+  { "exp", exponential, exponential_prime, exponential_fixed, 0, 1, 0.5, 0.5671432904097838 },
+  { "kepler", kepler, kepler_prime, kepler_fixed, 0, 3, 1, 0 },
+  { "wilkinson10", wilkinson, wilkinson_prime, NULL, 6.6, 7.4, 6.8, 7 },
+  { "power10", power10, power10_prime, NULL, 0, 1.3, 1.3, 1 },
+  { "triple", triple, triple_prime, NULL, 0, 2.5, 2, 1 }
+};
+
+enum UnivariateMethod {
+  BISECTION,
+  LINEAR_ITERATION,
+  AITKENS_DELTA,
+  NEWTON,
+  SECANT,
+  FALSE_POSITION,
+  ILLINOIS,
+  ANDERSON_BJORCK,
+  BRENT,
+  MULLER,
+  UNIVARIATE_METHODS
+};
+
+static const char* univariateNames[UNIVARIATE_METHODS] = { "bisection", "linear_iteration", "aitkens_delta", "newton", "secant", "false_position", "illinois", "anderson_bjorck", "brent", "muller" };
+
+struct UnivariateCase {
+  const struct UnivariateProblem* problem;
+  enum UnivariateMethod method;
+};
+
+static void run_univariate_case(void* ptr, struct BenchmarkResult* result) {
+  const struct UnivariateCase* c = ptr;
+  const struct UnivariateProblem* p = c->problem;
+  struct SolverState state;
+  double x = NAN;
+  switch (c->method) {
+    case BISECTION:
+      x = bisection(p->f, p->a, p->b, MAX_ITER, PRECISION, false, &state);
+      break;
+    case LINEAR_ITERATION:
+      x = linear_iteration(p->g, p->x0, MAX_ITER, PRECISION, false, &state);
+      break;
+    case AITKENS_DELTA:
+      x = aitkens_delta(p->g, p->x0, MAX_ITER, PRECISION, false, &state);
+      break;
+    case NEWTON:
+      x = newton(p->f, p->fp, p->x0, MAX_ITER, PRECISION, false, &state);
+      break;
+    case SECANT:
+      x = secant(p->f, p->b, p->a, MAX_ITER, PRECISION, false, &state);
+      break;
+    case FALSE_POSITION:
+      x = false_position(p->f, p->b, p->a, MAX_ITER, PRECISION, false, &state);
+      break;
+    case ILLINOIS:
+      x = illinois(p->f, p->b, p->a, MAX_ITER, PRECISION, false, &state);
+      break;
+    case ANDERSON_BJORCK:
+      x = anderson_bjorck(p->f, p->b, p->a, MAX_ITER, PRECISION, false, &state);
+      break;
+    case BRENT:
+      x = brent(p->f, p->a, p->b, MAX_ITER, PRECISION, false, &state);
+      break;
+    case MULLER:
+      x = muller(p->f, p->b, (p->a + p->b) / 2, p->a, MAX_ITER, PRECISION, false, &state);
+      break;
+    case UNIVARIATE_METHODS:
+      break;
+  }
+  result->evaluations = state.evaluations;
+  result->iterations = state.iterations;
+  result->error = fabs(x - p->root);
+  result->termination = state.termination;
+}
+
+// REFERENCE ROOT FOR PROBLEMS WITHOUT A TABULATED ONE
+static double reference_root(const struct UnivariateProblem* p) {
+  long double x = p->x0;
+  for (int i = 0; i < 100; i++)
+    x -= (long double) p->f((double) x) / p->fp((double) x);
+  return (double) x;
+}
+
+// NONLINEAR SYSTEMS OF GROWING DIMENSION
+
+static unsigned int systemDimension;
+
+// BROYDEN'S TRIDIAGONAL FUNCTION: (3 - 2 x_i) x_i - x_(i-1) - 2 x_(i+1) + 1 = 0
+static void broyden_tridiagonal(const double* x, double* fx) {
+  const unsigned int n = systemDimension;
+  for (unsigned int i = 0; i < n; i++)
+    fx[i] = (3 - 2 * x[i]) * x[i] - (i ? x[i - 1] : 0) - 2 * (i + 1 < n ? x[i + 1] : 0) + 1;
+}
+
+static void broyden_tridiagonal_jacobian(const double* x, struct Matrix* J) {
+  const unsigned int n = systemDimension;
+  matrix_fill(J, 0);
+  for (unsigned int i = 0; i < n; i++) {
+    *matrix_element(J, i, i) = 3 - 4 * x[i];
+    if (i)
+      *matrix_element(J, i, i - 1) = -1;
+    if (i + 1 < n)
+      *matrix_element(J, i, i + 1) = -2;
+  }
+}
+
+// THE SAME FUNCTION ON DUAL NUMBERS, FOR THE EXACT JACOBIAN
+static void broyden_tridiagonal_dual(const struct DualBlock* x, struct DualBlock* fx) {
+  const unsigned int n = systemDimension;
+  for (unsigned int i = 0; i < n; i++) {
+    struct DualBlock t = dual_block_mul(dual_block_add_constant(dual_block_scale(x[i], -2), 3), x[i]);
+    if (i)
+      t = dual_block_sub(t, x[i - 1]);
+    if (i + 1 < n)
+      t = dual_block_sub(t, dual_block_scale(x[i + 1], 2));
+    fx[i] = dual_block_add_constant(t, 1);
+  }
+}
+
+// CONTRACTION FOR THE FIXED-POINT METHODS: x_i = (cos x_i + (x_(i-1) + x_(i+1)) / 4) / 2
+static void coupled_cosine(const double* x, double* gx) {
+  const unsigned int n = systemDimension;
+  for (unsigned int i = 0; i < n; i++)
+    gx[i] = (cos(x[i]) + ((i ? x[i - 1] : 0) + (i + 1 < n ? x[i + 1] : 0)) / 4) / 2;
+}
+
+enum MultivariateMethod {
+  LINEAR_ITERATION_MULTI,
+  AITKENS_DELTA_MULTI,
+  ANDERSON_MULTI,
+  NEWTON_MULTI,
+  NEWTON_MULTI_FD,
+  NEWTON_DUAL_MULTI,
+  NEWTON_CHORD_MULTI,
+  PSEUDO_NEWTON_MULTI,
+  PSEUDO_NEWTON_LIMITED_MULTI,
+  MULTIVARIATE_METHODS
+};
+
+static const char* multivariateNames[MULTIVARIATE_METHODS] = { "linear_iteration_multi", "aitkens_delta_multi", "anderson_multi", "newton_multi", "newton_multi_fd", "newton_dual_multi", "newton_chord_multi", "pseudo_newton_multi", "pseudo_newton_limited_multi" };
+
+struct MultivariateCase {
+  enum MultivariateMethod method;
+  unsigned int dimension;
+  double* x;
+  double* tmp1;
+  double* tmp2;
+};
+
+static void run_multivariate_case(void* ptr, struct BenchmarkResult* result) {
+  const struct MultivariateCase* c = ptr;
+  const unsigned int n = c->dimension;
+  const bool fixedPoint = c->method <= ANDERSON_MULTI;
+  for (unsigned int i = 0; i < n; i++)
+    c->x[i] = fixedPoint ? 0 : -1;
+  struct SolverState state;
+  switch (c->method) {
+    case LINEAR_ITERATION_MULTI:
+      linear_iteration_multi(coupled_cosine, c->x, c->tmp1, n, MAX_ITER, PRECISION, false, &state);
+      break;
+    case AITKENS_DELTA_MULTI:
+      aitkens_delta_multi(coupled_cosine, c->x, c->tmp1, c->tmp2, n, MAX_ITER, PRECISION, false, &state);
+      break;
+    case ANDERSON_MULTI:
+      anderson_multi(coupled_cosine, c->x, c->tmp1, n, 5, MAX_ITER, PRECISION, false, &state);
+      break;
+    case NEWTON_MULTI:
+      newton_multi(broyden_tridiagonal, broyden_tridiagonal_jacobian, c->x, c->tmp1, n, MAX_ITER, PRECISION, false, &state);
+      break;
+    case NEWTON_MULTI_FD:
+      newton_multi(broyden_tridiagonal, NULL, c->x, c->tmp1, n, MAX_ITER, PRECISION, false, &state);
+      break;
+    case NEWTON_DUAL_MULTI:
+      newton_dual_multi(broyden_tridiagonal_dual, c->x, c->tmp1, n, MAX_ITER, PRECISION, false, &state);
+      break;
+    case NEWTON_CHORD_MULTI:
+      newton_chord_multi(broyden_tridiagonal, broyden_tridiagonal_jacobian, c->x, c->tmp1, n, 5, MAX_ITER, PRECISION, false, &state);
+      break;
+    case PSEUDO_NEWTON_MULTI:
+      pseudo_newton_multi(broyden_tridiagonal, broyden_tridiagonal_jacobian, c->x, c->tmp1, n, MAX_ITER, PRECISION, false, &state);
+      break;
+    case PSEUDO_NEWTON_LIMITED_MULTI:
+      pseudo_newton_limited_multi(broyden_tridiagonal, c->x, c->tmp1, n, 10, 0, MAX_ITER, PRECISION, false, &state);
+      break;
+    case MULTIVARIATE_METHODS:
+      break;
+  }
+  if (fixedPoint) {
+    coupled_cosine(c->x, c->tmp1);
+    result->error = difference_norm(c->x, c->tmp1, n);
+  } else {
+    broyden_tridiagonal(c->x, c->tmp1);
+    result->error = sqrt(inner_product(c->tmp1, c->tmp1, n));
+  }
+  result->evaluations = state.evaluations;
+  result->iterations = state.iterations;
+  result->termination = state.termination;
+}
+
+// BATCHES OF INDEPENDENT CUBE ROOTS x^3 = c_k
+
+struct CubeRoots {
+  const double* c;
+  unsigned long evaluations;
+};
+
+static void cube_root_batch(const double* x, double* fx, const unsigned int* lane, const unsigned int n, void* data) {
+  struct CubeRoots* roots = data;
+  for (unsigned int k = 0; k < n; k++)
+    fx[k] = x[k] * x[k] * x[k] - roots->c[lane[k]];
+  roots->evaluations += n;
+}
+
+static void cube_root_batch_prime(const double* x, double* fx, const unsigned int* lane, const unsigned int n, void* data) {
+  (void) lane;
+  (void) data;
+  for (unsigned int k = 0; k < n; k++)
+    fx[k] = 3 * x[k] * x[k];
+}
+
+enum BatchMethod {
+  BISECTION_BATCH,
+  NEWTON_BATCH,
+  SECANT_BATCH,
+  BATCH_METHODS
+};
+
+static const char* batchNames[BATCH_METHODS] = { "bisection_batch", "newton_batch", "secant_batch" };
+
+struct BatchCase {
+  enum BatchMethod method;
+  unsigned int n;
+  struct CubeRoots roots;
+  double* lower;
+  double* upper;
+  double* x;
+  unsigned int* iterations;
+  enum SolverTermination* termination;
+};
+
+static void run_batch_case(void* ptr, struct BenchmarkResult* result) {
+  struct BatchCase* c = ptr;
+  c->roots.evaluations = 0;
+  switch (c->method) {
+    case BISECTION_BATCH:
+      bisection_batch(cube_root_batch, &c->roots, c->lower, c->upper, c->x, c->termination, c->iterations, c->n, MAX_ITER, PRECISION);
+      break;
+    case NEWTON_BATCH:
+      newton_batch(cube_root_batch, cube_root_batch_prime, &c->roots, c->upper, c->x, c->termination, c->iterations, c->n, MAX_ITER, PRECISION);
+      break;
+    case SECANT_BATCH:
+      secant_batch(cube_root_batch, &c->roots, c->upper, c->lower, c->x, c->termination, c->iterations, c->n, MAX_ITER, PRECISION);
+      break;
+    case BATCH_METHODS:
+      break;
+  }
+  result->evaluations = c->roots.evaluations;
+  result->iterations = 0;
+  result->error = 0;
+  result->termination = SOLVER_CONVERGED;
+  for (unsigned int k = 0; k < c->n; k++) {
+    if (c->iterations[k] > result->iterations)
+      result->iterations = c->iterations[k];
+    result->error = fmax(result->error, fabs(c->x[k] - cbrt(c->roots.c[k])));
+    if (c->termination[k] != SOLVER_CONVERGED)
+      result->termination = c->termination[k];
+  }
+}
+
+// BATCHES OF POLYNOMIALS WITH KNOWN REAL ROOTS: POLYNOMIAL k HAS THE degree CHEBYSHEV
+// POINTS OF [-1, 1] SHIFTED BY k / count, SO THE SORTED ROOTS COMPARE DIRECTLY
+
+struct PolynomialCase {
+  unsigned int count;
+  unsigned int degree;
+  const double* coefficients;
+  const double* expected;
+  double complex* roots;
+  unsigned int* found;
+};
+
+static void polynomial_problem(const unsigned int count, const unsigned int degree, double* coefficients, double* expected) {
+  for (unsigned int k = 0; k < count; k++) {
+    double* p = coefficients + (size_t) k * (degree + 1);
+    memset(p, 0, (degree + 1) * sizeof(double));
+    p[0] = 1;
+    for (unsigned int j = 0; j < degree; j++) {
+      const double root = -cos(M_PI * (2 * j + 1) / (2.0 * degree)) + (double) k / count;
+      expected[(size_t) k * degree + j] = root;
+      for (unsigned int i = j + 1; i > 0; i--)
+        p[i] -= root * p[i - 1];
+    }
+  }
+}
+
+static void run_polynomial_case(void* ptr, struct BenchmarkResult* result) {
+  const struct PolynomialCase* c = ptr;
+  polynomial_roots_batch(c->coefficients, c->degree, c->count, c->roots, c->found, 1e-14, 0);
+  result->evaluations = 0;
+  result->iterations = 0;
+  result->error = 0;
+  result->termination = SOLVER_CONVERGED;
+  for (unsigned int k = 0; k < c->count; k++) {
+    if (c->found[k] != c->degree)
+      result->termination = SOLVER_MAX_ITERATIONS;
+    for (unsigned int j = 0; j < c->found[k]; j++)
+      result->error = fmax(result->error, cabs(c->roots[(size_t) k * c->degree + j] - c->expected[(size_t) k * c->degree + j]));
+  }
+}
+
+int main(int argc, char** argv) {
+  const double minSeconds = benchmark_min_seconds(argc, argv);
+  struct BenchmarkResult result;
+  bool passed = true;
+  benchmark_header();
+
+  for (size_t p = 0; p < sizeof(problems) / sizeof(problems[0]); p++) {
+    if (problems[p].root == 0)
+      problems[p].root = reference_root(&problems[p]);
+    for (unsigned int m = 0; m < UNIVARIATE_METHODS; m++) {
+      if (!problems[p].g && (m == LINEAR_ITERATION || m == AITKENS_DELTA))
+        continue;
+      struct UnivariateCase c = { &problems[p], m };
+      const double seconds = benchmark_time(run_univariate_case, &c, &result, minSeconds);
+      benchmark_row_checked("univariate", univariateNames[m], problems[p].name, 1, 0, seconds, &result, ROOT_TOLERANCE);
+    }
+  }
+
+  for (unsigned int n = 2; n <= 512; n *= 4) {
+    systemDimension = n;
+    double* work = malloc(3 * (size_t) n * sizeof(double));
+    for (unsigned int m = 0; m < MULTIVARIATE_METHODS; m++) {
+      struct MultivariateCase c = { m, n, work, work + n, work + 2 * n };
+      const double seconds = benchmark_time(run_multivariate_case, &c, &result, minSeconds);
+      benchmark_row("multivariate", multivariateNames[m], (m <= ANDERSON_MULTI) ? "coupled_cosine" : "broyden_tridiagonal", n, 0, seconds, &result);
+      // EVERY NEWTON-TYPE METHOD SOLVES THE BROYDEN TRIDIAGONAL SYSTEM AT EVERY SIZE
+      if (m > ANDERSON_MULTI)
+        passed = benchmark_expect_converged(multivariateNames[m], "broyden_tridiagonal", n, &result) && passed;
+    }
+    free(work);
+  }
+
+  for (unsigned int n = 1024; n <= 65536; n *= 8) {
+    double* work = malloc(4 * (size_t) n * sizeof(double));
+    unsigned int* iterations = malloc(n * sizeof(unsigned int));
+    enum SolverTermination* termination = malloc(n * sizeof(enum SolverTermination));
+    for (unsigned int k = 0; k < n; k++) {
+      work[k] = 1 + 99.0 * k / n;
+      work[n + k] = 0;
+      work[2 * n + k] = 5;
+    }
+    for (unsigned int m = 0; m < BATCH_METHODS; m++) {
+      struct BatchCase c = { m, n, { work, 0 }, work + n, work + 2 * n, work + 3 * n, iterations, termination };
+      const double seconds = benchmark_time(run_batch_case, &c, &result, minSeconds);
+      benchmark_row_checked("batch", batchNames[m], "cube_roots", n, 0, seconds, &result, ROOT_TOLERANCE);
+    }
+    free(work);
+    free(iterations);
+    free(termination);
+  }
+
+  for (unsigned int degree = 4; degree <= 16; degree *= 2) {
+    const unsigned int count = 4096;
+    double* coefficients = malloc((size_t) count * (degree + 1) * sizeof(double));
+    double* expected = malloc((size_t) count * degree * sizeof(double));
+    double complex* roots = malloc((size_t) count * degree * sizeof(double complex));
+    unsigned int* found = malloc(count * sizeof(unsigned int));
+    polynomial_problem(count, degree, coefficients, expected);
+    struct PolynomialCase c = { count, degree, coefficients, expected, roots, found };
+    const double seconds = benchmark_time(run_polynomial_case, &c, &result, minSeconds);
+    benchmark_row("polynomial", "polynomial_roots_batch", "shifted_chebyshev", count, degree, seconds, &result);
+    free(coefficients);
+    free(expected);
+    free(roots);
+    free(found);
+  }
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+//
+//  template_benchmark.cpp
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Compares the C solvers (f called through a function pointer) with the nummet.hpp
+//  templates (f inlined) on many cheap solves, in the CSV format of benchmark.h.
+//  Build: cc -O3 -march=native -c ../source/*.c && c++ -std=c++17 -O3 -march=native -I../source template_benchmark.cpp *.o -lm -lpthread
+//
+
+#include <cmath>
+#include "nummet.hpp"
+
+extern "C" {
+#include "benchmark.h"
+#include "unisolvers.h"
+}
+
+#define SOLVES 1000
+
+// THE C API NEEDS THE PARAMETER IN A GLOBAL; THE TEMPLATES CAPTURE IT
+static double parameter;
+
+static double cube(const double x) { return x * x * x - parameter; }
+static double cube_prime(const double x) { return 3 * x * x; }
+
+struct Case {
+  bool templated;
+  int method;
+};
+
+static void run_case(void* ptr, struct BenchmarkResult* result) {
+  const Case* c = static_cast<const Case*>(ptr);
+  result->evaluations = 0;
+  result->iterations = 0;
+  result->error = 0;
+  result->termination = SOLVER_CONVERGED;
+  for (int k = 0; k < SOLVES; k++) {
+    const double p = 1 + k * 0.01;
+    double x;
+    struct SolverState state;
+    if (!c->templated) {
+      parameter = p;
+      x = (c->method == 0) ? newton(cube, cube_prime, 2, 100, 1e-12, false, &state) : brent(cube, 0, 3, 100, 1e-12, false, &state);
+      result->evaluations += state.evaluations;
+      result->iterations += state.iterations;
+    } else {
+      auto f = [p](double y) { return y * y * y - p; };
+      auto r = (c->method == 0) ? nummet::newton(f, [](double y) { return 3 * y * y; }, 2.0, 1e-12, 100) : nummet::brent(f, 0.0, 3.0, 1e-12, 100);
+      x = r.x;
+      result->evaluations += r.evaluations;
+      result->iterations += r.iterations;
+    }
+    result->error = std::fmax(result->error, std::fabs(x - std::cbrt(p)));
+  }
+}
+
+int main(int argc, char** argv) {
+  const double minSeconds = benchmark_min_seconds(argc, argv);
+  struct BenchmarkResult result;
+  const char* names[2] = { "newton", "brent" };
+  benchmark_header();
+  for (int method = 0; method < 2; method++) {
+    for (int templated = 0; templated < 2; templated++) {
+      Case c = { templated != 0, method };
+      const double seconds = benchmark_time(run_case, &c, &result, minSeconds);
+      benchmark_row(templated ? "template" : "c", names[method], "cube_roots", SOLVES, 0, seconds / SOLVES, &result);
+    }
+  }
+  return 0;
+}
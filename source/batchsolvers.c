@@ -0,0 +1,202 @@
+//
+//  batchsolvers.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/11/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "batchsolvers.h"
+#include "definitions.h"
+#include "solver.h"
+
+// FINISHED LANES KEEP THEIR SLOTS (AND KEEP BEING EVALUATED) UNTIL THEY MAKE UP THIS
+// FRACTION OF THE ACTIVE SET, AT WHICH POINT THE ARRAYS ARE PACKED
+#define BATCH_COMPACT_FRACTION 4
+#define BATCH_MAX_COLUMNS 5
+
+// STRUCTURE-OF-ARRAYS WORKING SET: SLOT k HOLDS PROBLEM lane[k]
+struct BatchLanes {
+  void* block;
+  unsigned int* lane;
+  unsigned char* done;
+  unsigned char* flag;
+  double* columns[BATCH_MAX_COLUMNS];
+  unsigned int ncolumns;
+  unsigned int active;
+  unsigned int finished;
+  double* roots;
+  enum SolverTermination* termination;
+  unsigned int* iterations;
+};
+
+static void init_batch_lanes(struct BatchLanes* lanes, const unsigned int n, const unsigned int ncolumns, double* roots, enum SolverTermination* termination, unsigned int* iterations) {
+  lanes->block = malloc((size_t) n * (ncolumns * sizeof(double) + sizeof(unsigned int) + 2));
+  if (n && !lanes->block) {
+    fprintf(stderr, "ERROR: Unable to allocate batch solver workspace\n");
+    exit(1);
+  }
+  for (unsigned int c = 0; c < ncolumns; c++)
+    lanes->columns[c] = (double*) lanes->block + (size_t) c * n;
+  lanes->lane = (unsigned int*) ((double*) lanes->block + (size_t) ncolumns * n);
+  lanes->done = (unsigned char*) (lanes->lane + n);
+  lanes->flag = lanes->done + n;
+  lanes->ncolumns = ncolumns;
+  lanes->active = n;
+  lanes->finished = 0;
+  lanes->roots = roots;
+  lanes->termination = termination;
+  lanes->iterations = iterations;
+  for (unsigned int k = 0; k < n; k++)
+    lanes->lane[k] = k;
+  memset(lanes->done, 0, n);
+}
+
+static inline void finish_lane(struct BatchLanes* lanes, const unsigned int k, const double root, const enum SolverTermination reason, const unsigned int iteration) {
+  if (lanes->done[k])
+    return;
+  const unsigned int lane = lanes->lane[k];
+  lanes->done[k] = 1;
+  lanes->finished++;
+  lanes->roots[lane] = root;
+  if (lanes->termination)
+    lanes->termination[lane] = reason;
+  if (lanes->iterations)
+    lanes->iterations[lane] = iteration;
+}
+
+// FINISHES EVERY LANE WHOSE flag IS SET: BIT 0 MEANS CONVERGED, BIT 1 MEANS THE ITERATE IS
+// NO LONGER FINITE
+static void finish_flagged_lanes(struct BatchLanes* lanes, const double* x, const unsigned int iteration) {
+  for (unsigned int k = 0; k < lanes->active; k++) {
+    if (lanes->flag[k])
+      finish_lane(lanes, k, x[k], (lanes->flag[k] & 1) ? SOLVER_CONVERGED : SOLVER_INVALID_ARGUMENT, iteration);
+  }
+}
+
+static void compact_batch_lanes(struct BatchLanes* lanes) {
+  if (!lanes->finished || lanes->finished * BATCH_COMPACT_FRACTION < lanes->active)
+    return;
+  unsigned int j = 0;
+  for (unsigned int k = 0; k < lanes->active; k++) {
+    if (lanes->done[k])
+      continue;
+    lanes->lane[j] = lanes->lane[k];
+    for (unsigned int c = 0; c < lanes->ncolumns; c++)
+      lanes->columns[c][j] = lanes->columns[c][k];
+    j++;
+  }
+  memset(lanes->done, 0, j);
+  lanes->active = j;
+  lanes->finished = 0;
+}
+
+static void destroy_batch_lanes(struct BatchLanes* lanes, const double* x, const unsigned int iteration) {
+  for (unsigned int k = 0; k < lanes->active; k++)
+    finish_lane(lanes, k, x[k], SOLVER_MAX_ITERATIONS, iteration);
+  free(lanes->block);
+}
+
+// BATCHED BISECTION METHOD IMPLEMENTATION
+void bisection_batch(const batch_function f, void* data, const double* x0, const double* x1, double* roots, enum SolverTermination* termination, unsigned int* iterations, const unsigned int n, const unsigned int max_iter, const double precision) {
+  struct BatchLanes lanes;
+  init_batch_lanes(&lanes, n, 5, roots, termination, iterations);
+  double* const a = lanes.columns[0];
+  double* const b = lanes.columns[1];
+  double* const fa = lanes.columns[2];
+  double* const m = lanes.columns[3];
+  double* const fm = lanes.columns[4];
+  memcpy(a, x0, n * sizeof(double));
+  memcpy(b, x1, n * sizeof(double));
+  f(a, fa, lanes.lane, n, data);
+  f(b, fm, lanes.lane, n, data);
+  for (unsigned int k = 0; k < n; k++) {
+    if (fa[k] == 0)
+      finish_lane(&lanes, k, a[k], SOLVER_CONVERGED, 0);
+    else if (fm[k] == 0)
+      finish_lane(&lanes, k, b[k], SOLVER_CONVERGED, 0);
+    else if (!(fa[k] * fm[k] < 0))
+      finish_lane(&lanes, k, a[k], SOLVER_INVALID_BRACKET, 0);
+  }
+  compact_batch_lanes(&lanes);
+  unsigned int iter = 0;
+  for (; lanes.active && (!max_iter || iter < max_iter); iter++) {
+    const unsigned int active = lanes.active;
+    for (unsigned int k = 0; k < active; k++) {
+      m[k] = 0.5 * (a[k] + b[k]);
+      lanes.flag[k] = 0.5 * fabs(b[k] - a[k]) < precision;
+    }
+    finish_flagged_lanes(&lanes, m, iter + 1);
+    compact_batch_lanes(&lanes);
+    if (!lanes.active)
+      break;
+    f(m, fm, lanes.lane, lanes.active, data);
+    for (unsigned int k = 0; k < lanes.active; k++) {
+      const bool left = fm[k] * fa[k] <= 0;
+      b[k] = left ? m[k] : b[k];
+      a[k] = left ? a[k] : m[k];
+      fa[k] = left ? fa[k] : fm[k];
+    }
+  }
+  destroy_batch_lanes(&lanes, a, iter);
+}
+
+// BATCHED NEWTON'S METHOD IMPLEMENTATION
+void newton_batch(const batch_function f, const batch_function fp, void* data, const double* x0, double* roots, enum SolverTermination* termination, unsigned int* iterations, const unsigned int n, const unsigned int max_iter, const double precision) {
+  struct BatchLanes lanes;
+  init_batch_lanes(&lanes, n, 3, roots, termination, iterations);
+  double* const x = lanes.columns[0];
+  double* const fx = lanes.columns[1];
+  double* const dfx = lanes.columns[2];
+  memcpy(x, x0, n * sizeof(double));
+  unsigned int iter = 0;
+  for (; lanes.active && (!max_iter || iter < max_iter); iter++) {
+    const unsigned int active = lanes.active;
+    f(x, fx, lanes.lane, active, data);
+    fp(x, dfx, lanes.lane, active, data);
+    for (unsigned int k = 0; k < active; k++) {
+      const double step = fx[k] / dfx[k];
+      x[k] -= step;
+      lanes.flag[k] = (fabs(step) < precision) | (!isfinite(x[k]) << 1);
+    }
+    finish_flagged_lanes(&lanes, x, iter + 1);
+    compact_batch_lanes(&lanes);
+  }
+  destroy_batch_lanes(&lanes, x, iter);
+}
+
+// BATCHED SECANT METHOD IMPLEMENTATION
+void secant_batch(const batch_function f, void* data, const double* x1, const double* x0, double* roots, enum SolverTermination* termination, unsigned int* iterations, const unsigned int n, const unsigned int max_iter, const double precision) {
+  struct BatchLanes lanes;
+  init_batch_lanes(&lanes, n, 4, roots, termination, iterations);
+  double* const xa = lanes.columns[0];
+  double* const fa = lanes.columns[1];
+  double* const xb = lanes.columns[2];
+  double* const fb = lanes.columns[3];
+  memcpy(xa, x0, n * sizeof(double));
+  memcpy(xb, x1, n * sizeof(double));
+  f(xa, fa, lanes.lane, n, data);
+  f(xb, fb, lanes.lane, n, data);
+  unsigned int iter = 0;
+  for (; lanes.active && (!max_iter || iter < max_iter); iter++) {
+    const unsigned int active = lanes.active;
+    for (unsigned int k = 0; k < active; k++) {
+      const double x2 = xb[k] - fb[k] * (xb[k] - xa[k]) / (fb[k] - fa[k]);
+      lanes.flag[k] = (fabs(x2 - xb[k]) < precision) | (!isfinite(x2) << 1);
+      xa[k] = xb[k];
+      fa[k] = fb[k];
+      xb[k] = x2;
+    }
+    finish_flagged_lanes(&lanes, xb, iter + 1);
+    compact_batch_lanes(&lanes);
+    if (lanes.active)
+      f(xb, fb, lanes.lane, lanes.active, data);
+  }
+  destroy_batch_lanes(&lanes, xb, iter);
+}
@@ -0,0 +1,37 @@
+//
+//  batchsolvers.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/11/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef batchsolvers_h
+#define batchsolvers_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+#include "solver.h"
+
+// VECTORISED FUNCTION: WRITES f(x[k]) TO fx[k] FOR k < n, WHERE lane[k] IS THE INDEX OF
+// THE PROBLEM x[k] BELONGS TO (E.G. TO LOOK UP ITS PARAMETERS IN data)
+typedef void (*batch_function)(const double* x, double* fx, const unsigned int* lane, const unsigned int n, void* data);
+
+// BATCH SOLVERS SOLVE n INDEPENDENT PROBLEMS AT ONCE, KEEPING THE UNCONVERGED LANES IN
+// STRUCTURE-OF-ARRAYS FORM AND COMPACTING AWAY CONVERGED LANES ONCE ENOUGH OF THEM FINISH
+// roots[i] RECEIVES THE RESULT FOR PROBLEM i. termination AND iterations MAY BE NULL
+
+// BATCHED BISECTION METHOD
+// CONVERGENCE: LINEAR (GUARANTEED)
+void bisection_batch(const batch_function f, void* data, const double* x0, const double* x1, double* roots, enum SolverTermination* termination, unsigned int* iterations, const unsigned int n, const unsigned int max_iter, const double precision);
+
+// BATCHED NEWTON'S METHOD
+// CONVERGENCE: QUADRATIC
+void newton_batch(const batch_function f, const batch_function fp, void* data, const double* x0, double* roots, enum SolverTermination* termination, unsigned int* iterations, const unsigned int n, const unsigned int max_iter, const double precision);
+
+// BATCHED SECANT METHOD
+// CONVERGENCE: SUPERLINEAR BUT NOT QUADRATIC
+void secant_batch(const batch_function f, void* data, const double* x1, const double* x0, double* roots, enum SolverTermination* termination, unsigned int* iterations, const unsigned int n, const unsigned int max_iter, const double precision);
+
+#endif /* batchsolvers_h */
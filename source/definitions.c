@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <math.h>
 #include "definitions.h"
+#include "matrixkernels.h"
 
 double binomial(const double n, const double k) {
   return tgamma(n + 1) / (tgamma(k + 1) * tgamma(n - k + 1));
@@ -18,61 +19,74 @@ double binomial(const double n, const double k) {
 
 struct Matrix* new_matrix(const unsigned int nrows, const unsigned int ncols) {
   struct Matrix* newMat = malloc(sizeof(struct Matrix));
-  newMat->array = malloc(nrows * sizeof(double*));
-  newMat->arrayTranspose = malloc(ncols * sizeof(double*));
-  newMat->ncols = ncols;
+  newMat->array = malloc(((size_t) nrows * ncols + 1) * sizeof(double));
   newMat->nrows = nrows;
-  for (unsigned int i = 0; i < nrows; i++)
-    (newMat->array)[i] = malloc(ncols * sizeof(double));
-  for (unsigned int i = 0; i < ncols; i++)
-    (newMat->arrayTranspose)[i] = malloc(nrows * sizeof(double));
+  newMat->ncols = ncols;
+  newMat->rowStride = ncols;
+  newMat->colStride = 1;
+  newMat->owner = true;
   return newMat;
 }
 
 struct Matrix* new_matrix_fill(const unsigned int nrows, const unsigned int ncols, const double fillVal) {
-  struct Matrix* newMat = malloc(sizeof(struct Matrix));
-  newMat->array = malloc(nrows * sizeof(double*));
-  newMat->arrayTranspose = malloc(ncols * sizeof(double*));
-  newMat->ncols = ncols;
-  newMat->nrows = nrows;
-  for (unsigned int i = 0; i < nrows; i++) {
-    (newMat->array)[i] = malloc(ncols * sizeof(double));
-    for (unsigned int j = 0; j < ncols; j++)
-      (newMat->array)[i][j] = fillVal;
-  }
-  for (unsigned int i = 0; i < ncols; i++) {
-    (newMat->arrayTranspose)[i] = malloc(nrows * sizeof(double));
-    for (unsigned int j = 0; j < nrows; j++)
-      (newMat->array)[i][j] = fillVal;
-  }
+  struct Matrix* newMat = new_matrix(nrows, ncols);
+  matrix_fill(newMat, fillVal);
   return newMat;
 }
 
 struct Matrix* new_matrix_eye(const unsigned int nrows, const unsigned int ncols) {
-  struct Matrix* newMat = malloc(sizeof(struct Matrix));
-  newMat->array = malloc(nrows * sizeof(double*));
-  newMat->arrayTranspose = malloc(ncols * sizeof(double*));
-  newMat->ncols = ncols;
-  newMat->nrows = nrows;
-  for (unsigned int i = 0; i < nrows; i++) {
-    (newMat->array)[i] = malloc(ncols * sizeof(double));
-    for (unsigned int j = 0; j < ncols; j++) {
-      if (i == j)
-        (newMat->array)[i][j] = 1.0;
-      else
-        (newMat->array)[i][j] = 0.0;
-    }
+  struct Matrix* newMat = new_matrix(nrows, ncols);
+  matrix_eye(newMat);
+  return newMat;
+}
+
+void destroy_matrix(struct Matrix* m) {
+  if (!m)
+    return;
+  if (m->owner)
+    free(m->array);
+  free(m);
+}
+
+struct Matrix matrix_view(double* array, const unsigned int nrows, const unsigned int ncols, const unsigned int rowStride) {
+  struct Matrix view = { array, nrows, ncols, rowStride, 1, false };
+  return view;
+}
+
+struct Matrix matrix_submatrix(const struct Matrix* m, const unsigned int row, const unsigned int col, const unsigned int nrows, const unsigned int ncols) {
+  if (row + nrows > m->nrows || col + ncols > m->ncols) {
+    fprintf(stderr, "ERROR: Submatrix exceeds matrix bounds\n");
+    exit(1);
   }
-  for (unsigned int i = 0; i < ncols; i++) {
-    (newMat->arrayTranspose)[i] = malloc(nrows * sizeof(double));
-    for (unsigned int j = 0; j < nrows; j++) {
-      if (i == j)
-        (newMat->array)[i][j] = 1.0;
-      else
-        (newMat->array)[i][j] = 0.0;
-    }
+  struct Matrix view = { matrix_element(m, row, col), nrows, ncols, m->rowStride, m->colStride, false };
+  return view;
+}
+
+struct Matrix matrix_transpose(const struct Matrix* m) {
+  struct Matrix view = { m->array, m->ncols, m->nrows, m->colStride, m->rowStride, false };
+  return view;
+}
+
+void matrix_fill(struct Matrix* m, const double fillVal) {
+  for (unsigned int i = 0; i < m->nrows; i++)
+    for (unsigned int j = 0; j < m->ncols; j++)
+      *matrix_element(m, i, j) = fillVal;
+}
+
+void matrix_eye(struct Matrix* m) {
+  for (unsigned int i = 0; i < m->nrows; i++)
+    for (unsigned int j = 0; j < m->ncols; j++)
+      *matrix_element(m, i, j) = (i == j) ? 1.0 : 0.0;
+}
+
+void matrix_copy(const struct Matrix* src, struct Matrix* dst) {
+  if (src->nrows != dst->nrows || src->ncols != dst->ncols) {
+    fprintf(stderr, "ERROR: Matrix dimensions do not match\n");
+    exit(1);
   }
-  return newMat;
+  for (unsigned int i = 0; i < src->nrows; i++)
+    for (unsigned int j = 0; j < src->ncols; j++)
+      *matrix_element(dst, i, j) = *matrix_element(src, i, j);
 }
 
 void print_vector(const double* v, const unsigned int dim, double precision) {
@@ -82,50 +96,21 @@ void print_vector(const double* v, const unsigned int dim, double precision) {
   printf(" ]\n");
 }
 
-double difference_norm(const double* v1, const double* v2, const unsigned int dim) {
-  double val = 0;
-  for (unsigned int i = 0; i < dim; i++)
-    val += (v1[i] - v2[i]) * (v1[i] - v2[i]);
-  return sqrt(val);
-}
-
-double inner_product(const double* v1, const double* v2, const unsigned int dim) {
-  double val = 0;
-  for (unsigned int i = 0; i < dim; i++)
-    val += v1[i] * v2[i];
-  return val;
-}
-
 struct Matrix* matrix_product(const struct Matrix* m1, const struct Matrix* m2, struct Matrix* ptr) {
-  ptr->nrows = m1->nrows;
-  ptr->ncols = m2->ncols;
-  double** matrixArray = malloc(ptr->nrows * sizeof(double*));
-  for (unsigned int i = 0; i < ptr->nrows; i++) {
-    matrixArray[i] = malloc(ptr->ncols * sizeof(double));
-    for (unsigned int j = 0; j < ptr->ncols; j++)
-      matrixArray[i][j] = inner_product((m1->array)[i], (m2->arrayTranspose)[j], m1->ncols);
-  }
-  ptr->array = matrixArray;
-  double** matrixArrayTranspose = malloc(ptr->ncols * sizeof(double*));
-  for (unsigned int i = 0; i < ptr->ncols; i++) {
-    matrixArrayTranspose[i] = malloc(ptr->nrows * sizeof(double));
-    for (unsigned int j = 0; j < ptr->nrows; j++)
-      matrixArrayTranspose[i][j] = ptr->array[j][i];
-  }
-  ptr->arrayTranspose = matrixArrayTranspose;
+  matrix_gemm(1.0, m1, m2, 0.0, ptr);
   return ptr;
 }
 
+// new_difference_table_degree, destroy_difference_table AND difference COME FROM THE
+// TEMPLATE SHARED WITH THE OTHER SCALAR TYPES (scalar.h)
+#define SCALAR double
+#define SCALAR_NAME(name) name
+#include "scalartable.h"
+#undef SCALAR
+#undef SCALAR_NAME
+
 struct DifferenceTable* new_difference_table(const double* val, const unsigned int npoints) {
-  struct DifferenceTable* newTable = malloc(sizeof(struct DifferenceTable));
-  newTable->npoints = npoints;
-  newTable->table = malloc(npoints * sizeof(double*));
-  for (int i = 0; i < npoints; i++) {
-    (newTable->table)[i] = malloc((npoints - i - 1) * sizeof(double));
-    for (int j = 1; j < npoints - i; j++)
-      (newTable->table)[i][j] = forward_difference(i, j, val, npoints);
-  }
-  return newTable;
+  return new_difference_table_degree(val, npoints, npoints > 0 ? npoints - 1 : 0);
 }
 
 double forward_difference(const unsigned int i, const unsigned int degree, const double* vals, const unsigned int npoints) {
@@ -133,14 +118,14 @@ double forward_difference(const unsigned int i, const unsigned int degree, const
     fprintf(stderr, "ERROR: Invalid difference operator degree\n");
     exit(1);
   }
-  if (degree == 1)
-    return vals[i + 1] - vals[i];
-  else
-    return forward_difference(i + 1, degree - 1, vals, npoints) - forward_difference(i, degree - 1, vals, npoints);
-}
-
-double difference(const struct DifferenceTable* table, const unsigned int index, const unsigned int degree) {
-  return (table->table)[index][degree - 1];
+  // Δ^k f_i = Σ (-1)^(k - j) C(k, j) f_(i + j)
+  double coefficient = (degree % 2) ? -1 : 1;
+  double val = 0;
+  for (unsigned int j = 0; j <= degree; j++) {
+    val += coefficient * vals[i + j];
+    coefficient *= -(double) (degree - j) / (j + 1);
+  }
+  return val;
 }
 
 double central_difference(const struct DifferenceTable* table, const unsigned int index, const unsigned int degree) {
@@ -150,3 +135,59 @@ double central_difference(const struct DifferenceTable* table, const unsigned in
   }
   return difference(table, index - degree / 2, degree);
 }
+
+struct StreamingDifferenceTable* new_streaming_difference_table(const unsigned int window, const unsigned int degree, const double x0, const double h_width) {
+  if (!window || degree > window - 1) {
+    fprintf(stderr, "ERROR: Invalid difference operator degree\n");
+    exit(1);
+  }
+  struct StreamingDifferenceTable* newTable = malloc(sizeof(struct StreamingDifferenceTable));
+  newTable->rings = malloc((size_t) (degree + 1) * window * sizeof(double));
+  newTable->window = window;
+  newTable->degree = degree;
+  newTable->count = 0;
+  newTable->x0 = x0;
+  newTable->h_width = h_width;
+  return newTable;
+}
+
+void destroy_streaming_difference_table(struct StreamingDifferenceTable* table) {
+  if (!table)
+    return;
+  free(table->rings);
+  free(table);
+}
+
+// RING OF ORDER k, SLOT OF GLOBAL SAMPLE i
+static inline double* streaming_slot(const struct StreamingDifferenceTable* table, const unsigned int degree, const unsigned long i) {
+  return table->rings + (size_t) degree * table->window + i % table->window;
+}
+
+void streaming_difference_append(struct StreamingDifferenceTable* table, const double value) {
+  const unsigned long n = table->count;
+  *streaming_slot(table, 0, n) = value;
+  // Δ^k f_(n - k) = Δ^(k - 1) f_(n - k + 1) - Δ^(k - 1) f_(n - k)
+  double previous = value;
+  for (unsigned int k = 1; k <= table->degree && k <= n; k++) {
+    previous -= *streaming_slot(table, k - 1, n - k);
+    *streaming_slot(table, k, n - k) = previous;
+  }
+  table->count = n + 1;
+}
+
+unsigned int streaming_difference_size(const struct StreamingDifferenceTable* table) {
+  return (table->count < table->window) ? (unsigned int) table->count : table->window;
+}
+
+double streaming_difference(const struct StreamingDifferenceTable* table, const unsigned int index, const unsigned int degree) {
+  const unsigned int size = streaming_difference_size(table);
+  if (degree > table->degree || index + degree >= size) {
+    fprintf(stderr, "ERROR: Difference outside of table range\n");
+    exit(1);
+  }
+  return *streaming_slot(table, degree, table->count - size + index);
+}
+
+double streaming_abscissa(const struct StreamingDifferenceTable* table, const unsigned int index) {
+  return table->x0 + (double) (table->count - streaming_difference_size(table) + index) * table->h_width;
+}
@@ -13,18 +13,26 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <math.h>
+#include <stdbool.h>
+
+struct Matrix;
 
 typedef double (*univariate_function)(const double);
 typedef void (*multivariate_function)(const double*, double*);
-typedef void(*matrix_function)(const double*, double**);
+typedef void(*matrix_function)(const double*, struct Matrix*);
 
 double binomial(const double n, const double k);
 
+// ELEMENT (i, j) IS STORED AT array[i * rowStride + j * colStride]
+// MATRICES FROM new_matrix* OWN A SINGLE ROW-MAJOR BUFFER (colStride == 1), WHILE VIEWS
+// SHARE THE BUFFER OF ANOTHER MATRIX AND MUST NOT OUTLIVE IT
 struct Matrix {
-  double** array;
-  double** arrayTranspose;
+  double* array;
   unsigned int nrows;
   unsigned int ncols;
+  unsigned int rowStride;
+  unsigned int colStride;
+  bool owner;
 };
 
 struct Matrix* new_matrix(const unsigned int nrows, const unsigned int ncols);
@@ -33,27 +41,90 @@ struct Matrix* new_matrix_fill(const unsigned int nrows, const unsigned int ncol
 
 struct Matrix* new_matrix_eye(const unsigned int nrows, const unsigned int ncols);
 
+void destroy_matrix(struct Matrix* m);
+
+static inline double* matrix_element(const struct Matrix* m, const unsigned int i, const unsigned int j) {
+  return m->array + (size_t) i * m->rowStride + (size_t) j * m->colStride;
+}
+
+// NON-OWNING VIEWS (NO COPY, NO ALLOCATION)
+struct Matrix matrix_view(double* array, const unsigned int nrows, const unsigned int ncols, const unsigned int rowStride);
+
+struct Matrix matrix_submatrix(const struct Matrix* m, const unsigned int row, const unsigned int col, const unsigned int nrows, const unsigned int ncols);
+
+struct Matrix matrix_transpose(const struct Matrix* m);
+
+// IN-PLACE OPERATIONS ON EXISTING MATRICES OR VIEWS
+void matrix_fill(struct Matrix* m, const double fillVal);
+
+void matrix_eye(struct Matrix* m);
+
+void matrix_copy(const struct Matrix* src, struct Matrix* dst);
+
 void print_vector(const double* v, const unsigned int dim, double precision);
 
+// THE VECTOR KERNELS ARE DISPATCHED BY INSTRUCTION SET AT LOAD TIME (vectorkernels.h)
 double difference_norm(const double* v1, const double* v2, const unsigned int dim);
 
+// ||v1 - v2|| WHEN IT IS AT MOST bound; OTHERWISE STOPS AS SOON AS A PARTIAL SUM PASSES bound
+// AND RETURNS THAT PARTIAL NORM (STILL GREATER THAN bound). IT SUMS IN CHUNKS, SO IT MAY
+// DIFFER FROM difference_norm IN THE LAST BITS
+double difference_norm_bounded(const double* v1, const double* v2, const unsigned int dim, const double bound);
+
 double inner_product(const double* v1, const double* v2, const unsigned int dim);
 
+// WRITES m1 * m2 INTO ptr, WHICH MUST ALREADY HAVE THE RESULT'S SHAPE AND MUST NOT
+// SHARE STORAGE WITH m1 OR m2
 struct Matrix* matrix_product(const struct Matrix* m1, const struct Matrix* m2, struct Matrix* ptr);
 
+// FORWARD DIFFERENCES OF EVERY ORDER UP TO degree, STORED ORDER BY ORDER IN ONE
+// CONTIGUOUS BUFFER (ORDER k HOLDS npoints - k ENTRIES, STARTING AT ORDER 1)
 struct DifferenceTable {
-  double** table;
+  double* table;
   unsigned long npoints;
+  unsigned int degree;
 };
 
 struct DifferenceTable* new_difference_table(const double* val, const unsigned int npoints);
 
+struct DifferenceTable* new_difference_table_degree(const double* val, const unsigned int npoints, const unsigned int degree);
+
+void destroy_difference_table(struct DifferenceTable* table);
+
 double forward_difference(const unsigned int i, const unsigned int degree, const double* vals, const unsigned int npoints);
 
 double difference(const struct DifferenceTable* table, const unsigned int index, const unsigned int degree);
 
 double central_difference(const struct DifferenceTable* table, const unsigned int index, const unsigned int degree);
 
+// SLIDING WINDOW OVER THE LAST window SAMPLES OF A UNIFORM SERIES (x_i = x0 + i * h_width)
+// AND THEIR FORWARD DIFFERENCES UP TO degree. EVERY ORDER IS A RING BUFFER, SO APPENDING A
+// SAMPLE ONLY COMPUTES THE NEW DIAGONAL OF DIFFERENCES (O(degree), NO ALLOCATION) AND THE
+// OLDEST SAMPLE DROPS OUT ONCE THE WINDOW IS FULL
+struct StreamingDifferenceTable {
+  double* rings;
+  unsigned int window;
+  unsigned int degree;
+  unsigned long count;
+  double x0;
+  double h_width;
+};
+
+struct StreamingDifferenceTable* new_streaming_difference_table(const unsigned int window, const unsigned int degree, const double x0, const double h_width);
+
+void destroy_streaming_difference_table(struct StreamingDifferenceTable* table);
+
+void streaming_difference_append(struct StreamingDifferenceTable* table, const double value);
+
+// NUMBER OF SAMPLES CURRENTLY IN THE WINDOW
+unsigned int streaming_difference_size(const struct StreamingDifferenceTable* table);
+
+// Δ^degree f AT POSITION index OF THE WINDOW (0 IS THE OLDEST SAMPLE); degree 0 GIVES THE SAMPLE
+double streaming_difference(const struct StreamingDifferenceTable* table, const unsigned int index, const unsigned int degree);
+
+// ABSCISSA OF POSITION index OF THE WINDOW
+double streaming_abscissa(const struct StreamingDifferenceTable* table, const unsigned int index);
+
 
 
 
@@ -0,0 +1,39 @@
+//
+//  dual.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "dual.h"
+#include "definitions.h"
+
+unsigned int dual_jacobian(const dual_multivariate_function f, const double* x, double* fx, struct Matrix* J, const unsigned int dimension, struct DualBlock* work) {
+  struct DualBlock* in = work;
+  struct DualBlock* out = work + dimension;
+  unsigned int calls = 0;
+  for (unsigned int first = 0; first < dimension; first += DUAL_LANES) {
+    // SEED LANE l WITH THE UNIT DIRECTION OF COLUMN first + l
+    for (unsigned int j = 0; j < dimension; j++) {
+      in[j] = dual_block_constant(x[j]);
+      if (j >= first && j - first < DUAL_LANES)
+        in[j].derivative[j - first] = 1;
+    }
+    f(in, out);
+    calls++;
+    const unsigned int lanes = (dimension - first < DUAL_LANES) ? dimension - first : DUAL_LANES;
+    for (unsigned int i = 0; i < dimension; i++) {
+      for (unsigned int l = 0; l < lanes; l++)
+        *matrix_element(J, i, first + l) = out[i].derivative[l];
+    }
+    if (first == 0) {
+      for (unsigned int i = 0; i < dimension; i++)
+        fx[i] = out[i].value;
+    }
+  }
+  return calls;
+}
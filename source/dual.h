@@ -0,0 +1,254 @@
+//
+//  dual.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef dual_h
+#define dual_h
+
+#include <math.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// FORWARD-MODE AUTOMATIC DIFFERENTIATION. A FUNCTION WRITTEN WITH THE OPERATIONS BELOW
+// RETURNS ITS VALUE AND ITS EXACT DERIVATIVE IN ONE PASS
+
+// value + derivative ε, WITH ε^2 = 0
+struct Dual {
+  double value;
+  double derivative;
+};
+
+typedef struct Dual (*dual_function)(const struct Dual);
+
+// VECTOR MODE: DUAL_LANES DIRECTIONAL DERIVATIVES CARRIED TOGETHER. THE LANE LOOPS HAVE A
+// FIXED TRIP COUNT, SO THE COMPILER KEEPS THEM IN SIMD REGISTERS
+#ifndef DUAL_LANES
+#define DUAL_LANES 8
+#endif
+
+struct DualBlock {
+  double value;
+  double derivative[DUAL_LANES];
+};
+
+// F : R^n -> R^n WRITTEN AGAINST struct DualBlock, IN THE SHAPE OF multivariate_function
+typedef void (*dual_multivariate_function)(const struct DualBlock*, struct DualBlock*);
+
+// fx = F(x) AND THE dimension x dimension JACOBIAN J FROM ceil(dimension / DUAL_LANES) CALLS
+// OF f, EACH SEEDED WITH THE NEXT DUAL_LANES UNIT DIRECTIONS. work HOLDS 2 * dimension
+// BLOCKS. RETURNS THE NUMBER OF f CALLS
+unsigned int dual_jacobian(const dual_multivariate_function f, const double* x, double* fx, struct Matrix* J, const unsigned int dimension, struct DualBlock* work);
+
+// SCALAR DUALS
+
+static inline struct Dual dual_constant(const double c) {
+  const struct Dual d = { c, 0 };
+  return d;
+}
+
+static inline struct Dual dual_variable(const double x) {
+  const struct Dual d = { x, 1 };
+  return d;
+}
+
+// g(x) GIVEN g(x.value) AND g'(x.value)
+static inline struct Dual dual_chain(const struct Dual x, const double value, const double slope) {
+  const struct Dual d = { value, slope * x.derivative };
+  return d;
+}
+
+static inline struct Dual dual_add(const struct Dual a, const struct Dual b) {
+  const struct Dual d = { a.value + b.value, a.derivative + b.derivative };
+  return d;
+}
+
+static inline struct Dual dual_sub(const struct Dual a, const struct Dual b) {
+  const struct Dual d = { a.value - b.value, a.derivative - b.derivative };
+  return d;
+}
+
+static inline struct Dual dual_mul(const struct Dual a, const struct Dual b) {
+  const struct Dual d = { a.value * b.value, a.derivative * b.value + a.value * b.derivative };
+  return d;
+}
+
+static inline struct Dual dual_div(const struct Dual a, const struct Dual b) {
+  const double q = a.value / b.value;
+  const struct Dual d = { q, (a.derivative - q * b.derivative) / b.value };
+  return d;
+}
+
+static inline struct Dual dual_neg(const struct Dual a) {
+  const struct Dual d = { -a.value, -a.derivative };
+  return d;
+}
+
+static inline struct Dual dual_add_constant(const struct Dual a, const double c) {
+  const struct Dual d = { a.value + c, a.derivative };
+  return d;
+}
+
+static inline struct Dual dual_scale(const struct Dual a, const double c) {
+  const struct Dual d = { c * a.value, c * a.derivative };
+  return d;
+}
+
+static inline struct Dual dual_sin(const struct Dual x) {
+  return dual_chain(x, sin(x.value), cos(x.value));
+}
+
+static inline struct Dual dual_cos(const struct Dual x) {
+  return dual_chain(x, cos(x.value), -sin(x.value));
+}
+
+static inline struct Dual dual_tan(const struct Dual x) {
+  const double t = tan(x.value);
+  return dual_chain(x, t, 1 + t * t);
+}
+
+static inline struct Dual dual_exp(const struct Dual x) {
+  const double e = exp(x.value);
+  return dual_chain(x, e, e);
+}
+
+static inline struct Dual dual_log(const struct Dual x) {
+  return dual_chain(x, log(x.value), 1 / x.value);
+}
+
+static inline struct Dual dual_sqrt(const struct Dual x) {
+  const double r = sqrt(x.value);
+  return dual_chain(x, r, 0.5 / r);
+}
+
+// x^p FOR A CONSTANT EXPONENT. THE VALUE IS pow(x, p) ITSELF, NOT x^(p - 1) * x, WHICH IS
+// inf * 0 AT x = 0 FOR p < 1. p = 0 HAS DERIVATIVE 0 EVERYWHERE
+static inline struct Dual dual_pow(const struct Dual x, const double p) {
+  const double r = pow(x.value, p - 1);
+  return dual_chain(x, pow(x.value, p), p == 0 ? 0 : p * r);
+}
+
+static inline struct Dual dual_atan(const struct Dual x) {
+  return dual_chain(x, atan(x.value), 1 / (1 + x.value * x.value));
+}
+
+static inline struct Dual dual_tanh(const struct Dual x) {
+  const double t = tanh(x.value);
+  return dual_chain(x, t, 1 - t * t);
+}
+
+static inline struct Dual dual_fabs(const struct Dual x) {
+  return (x.value < 0) ? dual_neg(x) : x;
+}
+
+// VECTOR-MODE DUALS, WITH THE SAME OPERATIONS
+
+static inline struct DualBlock dual_block_constant(const double c) {
+  struct DualBlock d = { c, { 0 } };
+  return d;
+}
+
+static inline struct DualBlock dual_block_chain(const struct DualBlock* x, const double value, const double slope) {
+  struct DualBlock d;
+  d.value = value;
+  for (unsigned int l = 0; l < DUAL_LANES; l++)
+    d.derivative[l] = slope * x->derivative[l];
+  return d;
+}
+
+static inline struct DualBlock dual_block_add(const struct DualBlock a, const struct DualBlock b) {
+  struct DualBlock d;
+  d.value = a.value + b.value;
+  for (unsigned int l = 0; l < DUAL_LANES; l++)
+    d.derivative[l] = a.derivative[l] + b.derivative[l];
+  return d;
+}
+
+static inline struct DualBlock dual_block_sub(const struct DualBlock a, const struct DualBlock b) {
+  struct DualBlock d;
+  d.value = a.value - b.value;
+  for (unsigned int l = 0; l < DUAL_LANES; l++)
+    d.derivative[l] = a.derivative[l] - b.derivative[l];
+  return d;
+}
+
+static inline struct DualBlock dual_block_mul(const struct DualBlock a, const struct DualBlock b) {
+  struct DualBlock d;
+  d.value = a.value * b.value;
+  for (unsigned int l = 0; l < DUAL_LANES; l++)
+    d.derivative[l] = a.derivative[l] * b.value + a.value * b.derivative[l];
+  return d;
+}
+
+static inline struct DualBlock dual_block_div(const struct DualBlock a, const struct DualBlock b) {
+  struct DualBlock d;
+  d.value = a.value / b.value;
+  const double inverse = 1 / b.value;
+  for (unsigned int l = 0; l < DUAL_LANES; l++)
+    d.derivative[l] = (a.derivative[l] - d.value * b.derivative[l]) * inverse;
+  return d;
+}
+
+static inline struct DualBlock dual_block_neg(const struct DualBlock a) {
+  return dual_block_chain(&a, -a.value, -1);
+}
+
+static inline struct DualBlock dual_block_add_constant(struct DualBlock a, const double c) {
+  a.value += c;
+  return a;
+}
+
+static inline struct DualBlock dual_block_scale(const struct DualBlock a, const double c) {
+  return dual_block_chain(&a, c * a.value, c);
+}
+
+static inline struct DualBlock dual_block_sin(const struct DualBlock x) {
+  return dual_block_chain(&x, sin(x.value), cos(x.value));
+}
+
+static inline struct DualBlock dual_block_cos(const struct DualBlock x) {
+  return dual_block_chain(&x, cos(x.value), -sin(x.value));
+}
+
+static inline struct DualBlock dual_block_tan(const struct DualBlock x) {
+  const double t = tan(x.value);
+  return dual_block_chain(&x, t, 1 + t * t);
+}
+
+static inline struct DualBlock dual_block_exp(const struct DualBlock x) {
+  const double e = exp(x.value);
+  return dual_block_chain(&x, e, e);
+}
+
+static inline struct DualBlock dual_block_log(const struct DualBlock x) {
+  return dual_block_chain(&x, log(x.value), 1 / x.value);
+}
+
+static inline struct DualBlock dual_block_sqrt(const struct DualBlock x) {
+  const double r = sqrt(x.value);
+  return dual_block_chain(&x, r, 0.5 / r);
+}
+
+static inline struct DualBlock dual_block_pow(const struct DualBlock x, const double p) {
+  const double r = pow(x.value, p - 1);
+  return dual_block_chain(&x, pow(x.value, p), p == 0 ? 0 : p * r);
+}
+
+static inline struct DualBlock dual_block_atan(const struct DualBlock x) {
+  return dual_block_chain(&x, atan(x.value), 1 / (1 + x.value * x.value));
+}
+
+static inline struct DualBlock dual_block_tanh(const struct DualBlock x) {
+  const double t = tanh(x.value);
+  return dual_block_chain(&x, t, 1 - t * t);
+}
+
+static inline struct DualBlock dual_block_fabs(const struct DualBlock x) {
+  return (x.value < 0) ? dual_block_neg(x) : x;
+}
+
+#endif /* dual_h */
@@ -7,6 +7,7 @@
 //
 
 #include <math.h>
+#include <float.h>
 #include <string.h>
 #include <fenv.h>
 #include <stdio.h>
@@ -15,6 +16,11 @@
 #include <stdlib.h>
 #include "definitions.h"
 #include "interpolation.h"
+#include "tablecache.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 double lagrange(const double xinput, const double* xval, const double* fval, const unsigned int npoints) {
   double pval = 0;
@@ -29,6 +35,148 @@ double lagrange(const double xinput, const double* xval, const double* fval, con
   return pval;
 }
 
+static struct BarycentricInterpolant* allocate_barycentric(const unsigned int npoints) {
+  struct BarycentricInterpolant* interpolant = malloc(sizeof(struct BarycentricInterpolant));
+  interpolant->npoints = npoints;
+  interpolant->capacity = npoints ? npoints : 1;
+  interpolant->xval = malloc(interpolant->capacity * sizeof(double));
+  interpolant->fval = malloc(interpolant->capacity * sizeof(double));
+  interpolant->weights = malloc(interpolant->capacity * sizeof(double));
+  return interpolant;
+}
+
+struct BarycentricInterpolant* new_barycentric(const double* xval, const double* fval, const unsigned int npoints) {
+  struct BarycentricInterpolant* interpolant = allocate_barycentric(npoints);
+  memcpy(interpolant->xval, xval, npoints * sizeof(double));
+  memcpy(interpolant->fval, fval, npoints * sizeof(double));
+  for (unsigned int j = 0; j < npoints; j++) {
+    double product = 1;
+    for (unsigned int k = 0; k < npoints; k++) {
+      if (k != j)
+        product *= xval[j] - xval[k];
+    }
+    if (product == 0) {
+      fprintf(stderr, "ERROR: Interpolation nodes must be distinct\n");
+      exit(1);
+    }
+    interpolant->weights[j] = 1 / product;
+  }
+  return interpolant;
+}
+
+struct BarycentricInterpolant* new_barycentric_equispaced(const double x0, const double h_width, const double* fval, const unsigned int npoints) {
+  struct BarycentricInterpolant* interpolant = allocate_barycentric(npoints);
+  memcpy(interpolant->fval, fval, npoints * sizeof(double));
+  // w_j = (-1)^j C(n - 1, j), A COMMON MULTIPLE OF THE TRUE WEIGHTS
+  double weight = 1;
+  for (unsigned int j = 0; j < npoints; j++) {
+    interpolant->xval[j] = x0 + j * h_width;
+    interpolant->weights[j] = weight;
+    weight *= -(double) (npoints - 1 - j) / (j + 1);
+  }
+  return interpolant;
+}
+
+struct BarycentricInterpolant* new_barycentric_chebyshev(const double a, const double b, const double* fval, const unsigned int npoints) {
+  struct BarycentricInterpolant* interpolant = allocate_barycentric(npoints);
+  memcpy(interpolant->fval, fval, npoints * sizeof(double));
+  // w_j = (-1)^j, HALVED AT BOTH ENDS
+  for (unsigned int j = 0; j < npoints; j++) {
+    interpolant->xval[j] = (npoints > 1) ? 0.5 * (a + b) + 0.5 * (b - a) * cos(M_PI * j / (npoints - 1)) : 0.5 * (a + b);
+    interpolant->weights[j] = (j % 2) ? -1.0 : 1.0;
+    if (j == 0 || j == npoints - 1)
+      interpolant->weights[j] *= 0.5;
+  }
+  return interpolant;
+}
+
+void destroy_barycentric(struct BarycentricInterpolant* interpolant) {
+  if (!interpolant)
+    return;
+  free(interpolant->xval);
+  free(interpolant->fval);
+  free(interpolant->weights);
+  free(interpolant);
+}
+
+void barycentric_add_node(struct BarycentricInterpolant* interpolant, const double xnew, const double fnew) {
+  const unsigned int n = interpolant->npoints;
+  if (n == interpolant->capacity) {
+    interpolant->capacity *= 2;
+    interpolant->xval = realloc(interpolant->xval, interpolant->capacity * sizeof(double));
+    interpolant->fval = realloc(interpolant->fval, interpolant->capacity * sizeof(double));
+    interpolant->weights = realloc(interpolant->weights, interpolant->capacity * sizeof(double));
+  }
+  double* xval = interpolant->xval;
+  double* weights = interpolant->weights;
+  // THE STORED WEIGHTS MAY BE A COMMON MULTIPLE OF 1 / prod(x_j - x_k); RECOVER THAT
+  // MULTIPLE FROM THE FIRST NODE SO THE NEW WEIGHT GETS THE SAME SCALING
+  double scale = n ? weights[0] : 1;
+  for (unsigned int k = 1; k < n; k++)
+    scale *= xval[0] - xval[k];
+  double product = 1;
+  for (unsigned int j = 0; j < n; j++) {
+    const double d = xval[j] - xnew;
+    if (d == 0) {
+      fprintf(stderr, "ERROR: Interpolation nodes must be distinct\n");
+      exit(1);
+    }
+    weights[j] /= d;
+    product *= -d;
+  }
+  xval[n] = xnew;
+  interpolant->fval[n] = fnew;
+  weights[n] = scale / product;
+  interpolant->npoints = n + 1;
+}
+
+double barycentric(const struct BarycentricInterpolant* interpolant, const double xinput) {
+  double numerator = 0, denominator = 0;
+  for (unsigned int j = 0; j < interpolant->npoints; j++) {
+    const double d = xinput - interpolant->xval[j];
+    if (d == 0)
+      return interpolant->fval[j];
+    const double t = interpolant->weights[j] / d;
+    numerator += t * interpolant->fval[j];
+    denominator += t;
+  }
+  return numerator / denominator;
+}
+
+// QUERIES ARE PROCESSED IN BLOCKS SMALL ENOUGH TO KEEP THEIR SUMS IN L1, WITH THE NODE
+// LOOP OUTSIDE SO THE INNER LOOP RUNS ACROSS QUERY POINTS AND VECTORISES
+#define BARYCENTRIC_BLOCK 256
+
+void barycentric_batch(const struct BarycentricInterpolant* interpolant, const double* xinput, double* output, const unsigned int ninputs) {
+  double numerator[BARYCENTRIC_BLOCK], denominator[BARYCENTRIC_BLOCK];
+  unsigned int hit[BARYCENTRIC_BLOCK];
+  const unsigned int n = interpolant->npoints;
+  for (unsigned int start = 0; start < ninputs; start += BARYCENTRIC_BLOCK) {
+    const unsigned int m = (ninputs - start < BARYCENTRIC_BLOCK) ? ninputs - start : BARYCENTRIC_BLOCK;
+    const double* x = xinput + start;
+    for (unsigned int q = 0; q < m; q++) {
+      numerator[q] = 0;
+      denominator[q] = 0;
+      hit[q] = n;
+    }
+    for (unsigned int j = 0; j < n; j++) {
+      const double xj = interpolant->xval[j];
+      const double wj = interpolant->weights[j];
+      const double fj = interpolant->fval[j];
+      for (unsigned int q = 0; q < m; q++) {
+        const double d = x[q] - xj;
+        const bool exact = d == 0;
+        const double t = wj / (exact ? 1.0 : d);
+        numerator[q] += t * fj;
+        denominator[q] += t;
+        hit[q] = exact ? j : hit[q];
+      }
+    }
+    for (unsigned int q = 0; q < m; q++)
+      output[start + q] = (hit[q] < n) ? interpolant->fval[hit[q]] : numerator[q] / denominator[q];
+  }
+}
+
 double aitken_helper(const double xinput, const double* xval, const double* fval, const unsigned int count, const unsigned int npoints)  {
   if (npoints - count > 1) {
     double polyVals[(npoints - count - 1) * sizeof(double)];
@@ -45,17 +193,33 @@ double aitken(const double xinput, const double* xval, const double* fval, const
   return aitken_helper(xinput, xval, fval, 0, npoints);
 }
 
+// THE PLAN BUILDER AND EVALUATOR (fill_plan_coefficients, evaluate_plan_coefficients) AND THE
+// InterpolationPlan ROUTINES COME FROM THE TEMPLATE SHARED WITH THE OTHER SCALAR TYPES (scalar.h)
+#define SCALAR double
+#define SCALAR_NAME(name) name
+#include "scalarplan.h"
+#undef SCALAR
+#undef SCALAR_NAME
+
+static double streaming_lookup(const void* source, const unsigned int index, const unsigned int degree) {
+  return streaming_difference(source, index, degree);
+}
+
+static double evaluate_formula(const struct DifferenceTable* table, const double* fval, const enum InterpolationFormula formula, const unsigned int degree, const unsigned int index, const double s) {
+  const struct TableSource source = { table, fval };
+  double coefficients[plan_size(formula, degree)];
+  fill_plan_coefficients(table_lookup, &source, formula, degree, index, coefficients);
+  return evaluate_plan_coefficients(formula, degree, coefficients, s);
+}
+
 double newton_ascending2(const double xinput, const double* xval, const double* fval, const unsigned int degree, const double h_width, const  unsigned int npoints) {
   if (degree > npoints - 1) {
     fprintf(stderr, "ERROR:Invalid degree provided\n");
     exit(1);
   }
-  struct DifferenceTable* differenceTable = new_difference_table(fval, npoints);
-  double s = (xinput - xval[0]) / h_width;
-  double polyVal = fval[0];
-  for (unsigned int i = 1; i <= degree; i++)
-    polyVal += difference(differenceTable, 0, i) * binomial(s, i);
-  free(differenceTable);
+  const struct DifferenceTable* differenceTable = acquire_difference_table(fval, npoints, degree);
+  const double polyVal = evaluate_formula(differenceTable, fval, NEWTON_ASCENDING, degree, 0, (xinput - xval[0]) / h_width);
+  release_difference_table(differenceTable);
   return polyVal;
 }
 
@@ -64,103 +228,261 @@ double newton_ascending(const struct DifferenceTable* differenceTable, const dou
     fprintf(stderr, "ERROR:Invalid degree provided\n");
     exit(1);
   }
-  double s = (xinput - xval[0]) / h_width;
-  double polyVal = fval[0];
-  for (unsigned int i = 1; i <= degree; i++)
-    polyVal += difference(differenceTable, 0, i) * binomial(s, i);
-  return polyVal;
+  return evaluate_formula(differenceTable, fval, NEWTON_ASCENDING, degree, 0, (xinput - xval[0]) / h_width);
 }
 
 double newton_descending2(const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints) {
-  if (degree > npoints - 1) {
+  if (!stencil_fits(NEWTON_DESCENDING, degree, index, npoints)) {
     fprintf(stderr, "ERROR: Invalid degree provided\n");
     exit(1);
   }
-  struct DifferenceTable* differenceTable = new_difference_table(fval, npoints);
-  double s = (xinput - xval[index]) / h_width;
-  double polyVal = fval[index];
-  for (unsigned int i = 1; i <= degree; i++)
-    polyVal += difference(differenceTable, index - i, i) * binomial(s + i - 1, i);
-  free(differenceTable);
+  const struct DifferenceTable* differenceTable = acquire_difference_table(fval, npoints, degree);
+  const double polyVal = evaluate_formula(differenceTable, fval, NEWTON_DESCENDING, degree, index, (xinput - xval[index]) / h_width);
+  release_difference_table(differenceTable);
   return polyVal;
 }
 
 double newton_descending(const struct DifferenceTable* differenceTable, const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints) {
-  if (degree - index > npoints - 1) {
+  if (!stencil_fits(NEWTON_DESCENDING, degree, index, npoints)) {
     fprintf(stderr, "ERROR: Invalid degree provided\n");
     exit(1);
   }
-  double s = (xinput - xval[index]) / h_width;
-  double polyVal = fval[index];
-  for (unsigned int i = 1; i <= degree; i++)
-    polyVal += difference(differenceTable, index - i, i) * binomial(s + i - 1, i);
-  return polyVal;
+  return evaluate_formula(differenceTable, fval, NEWTON_DESCENDING, degree, index, (xinput - xval[index]) / h_width);
 }
 
 double stirling2(const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints) {
-  if (degree > npoints - 1) {
+  if (!stencil_fits(STIRLING, degree, index, npoints)) {
     fprintf(stderr, "ERROR: Invalid degree provided\n");
     exit(1);
   }
-  struct DifferenceTable* differenceTable = new_difference_table(fval, npoints);
-  double s = (xinput - xval[index]) / h_width;
-  double polyVal = fval[index];
-  for (unsigned int i = 1; i <= degree; i++) {
-    if (!(i % 2)) {
-      polyVal += 0.5 * (binomial(s + i / 2 - 1, i) + binomial(s + i / 2, i)) * difference(differenceTable, index - i / 2, i);
-    } else {
-      polyVal += 0.5 * binomial(s + (i - 1) / 2, i) * (difference(differenceTable, index - (i - 1) / 2, i) + difference(differenceTable, index - 1 - (i - 1) / 2, i));
-    }
-  }
-  free(differenceTable);
+  const struct DifferenceTable* differenceTable = acquire_difference_table(fval, npoints, degree);
+  const double polyVal = evaluate_formula(differenceTable, fval, STIRLING, degree, index, (xinput - xval[index]) / h_width);
+  release_difference_table(differenceTable);
   return polyVal;
 }
 
 double stirling(const struct DifferenceTable* differenceTable, const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints) {
-  if (degree + index > npoints - 1) {
+  if (!stencil_fits(STIRLING, degree, index, npoints)) {
     fprintf(stderr, "ERROR: Invalid degree provided\n");
     exit(1);
   }
-  double s = (xinput - xval[index]) / h_width;
-  double polyVal = fval[index];
-  for (unsigned int i = 1; i <= degree; i++) {
-    if (!(i % 2)) {
-      polyVal += 0.5 * (binomial(s + i / 2 - 1, i) + binomial(s + i / 2, i)) * difference(differenceTable, index - i / 2, i);
-    } else {
-      polyVal += 0.5 * binomial(s + (i - 1) / 2, i) * (difference(differenceTable, index - (i - 1) / 2, i) + difference(differenceTable, index - 1 - (i - 1) / 2, i));
-    }
-  }
-  return polyVal;
+  return evaluate_formula(differenceTable, fval, STIRLING, degree, index, (xinput - xval[index]) / h_width);
 }
 
 double everett2(const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints) {
-  if (degree + index > npoints - 1) {
-    fprintf(stderr, "Invalid degree provided\n");
+  if (!stencil_fits(EVERETT, degree, index, npoints)) {
+    fprintf(stderr, "ERROR: Invalid degree provided\n");
     exit(1);
   }
-  struct DifferenceTable* differenceTable = new_difference_table(fval, npoints);
-  double s = (xinput - xval[index]) / h_width;
-  double p = 1 - s;
-  double polyVal = binomial(p, 1) * fval[index] + binomial(s, 1) * fval[index + 1];
-  for (unsigned int i = 1; i <= degree / 2; i++) {
-    polyVal += binomial(p + i, 2 * i + 1) * central_difference(differenceTable, index, 2 * i);
-    polyVal += binomial(s + i, 2 * i + 1) * central_difference(differenceTable, index + 1, 2 * i);
-  }
-  free(differenceTable);
+  const struct DifferenceTable* differenceTable = acquire_difference_table(fval, npoints, degree);
+  const double polyVal = evaluate_formula(differenceTable, fval, EVERETT, degree, index, (xinput - xval[index]) / h_width);
+  release_difference_table(differenceTable);
   return polyVal;
 }
 
 double everett(const struct DifferenceTable* differenceTable, const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints) {
-  if (degree > npoints - 1) {
-    fprintf(stderr, "Invalid degree provided\n");
+  if (!stencil_fits(EVERETT, degree, index, npoints)) {
+    fprintf(stderr, "ERROR: Invalid degree provided\n");
+    exit(1);
+  }
+  return evaluate_formula(differenceTable, fval, EVERETT, degree, index, (xinput - xval[index]) / h_width);
+}
+
+double newton_descending_streaming(const struct StreamingDifferenceTable* table, const double xinput, const unsigned int degree) {
+  const unsigned int size = streaming_difference_size(table);
+  if (degree > table->degree || degree + 1 > size) {
+    fprintf(stderr, "ERROR: Invalid degree provided\n");
     exit(1);
   }
-  double s = (xinput - xval[index]) / h_width;
-  double p = 1 - s;
-  double polyVal = binomial(p, 1) * fval[index] + binomial(s, 1) * fval[index + 1];
-  for (unsigned int i = 1; i <= degree / 2; i++) {
-    polyVal += binomial(p + i, 2 * i + 1) * central_difference(differenceTable, index, 2 * i);
-    polyVal += binomial(s + i, 2 * i + 1) * central_difference(differenceTable, index + 1, 2 * i);
+  const unsigned int index = size - 1;
+  double coefficients[plan_size(NEWTON_DESCENDING, degree)];
+  fill_plan_coefficients(streaming_lookup, table, NEWTON_DESCENDING, degree, index, coefficients);
+  return evaluate_plan_coefficients(NEWTON_DESCENDING, degree, coefficients, (xinput - streaming_abscissa(table, index)) / table->h_width);
+}
+
+double stirling_streaming(const struct StreamingDifferenceTable* table, const double xinput, const unsigned int degree) {
+  const unsigned int size = streaming_difference_size(table);
+  const unsigned int half = (degree + 1) / 2;
+  if (degree > table->degree || 2 * half + 1 > size) {
+    fprintf(stderr, "ERROR: Invalid degree provided\n");
+    exit(1);
+  }
+  const unsigned int index = size - 1 - half;
+  double coefficients[plan_size(STIRLING, degree)];
+  fill_plan_coefficients(streaming_lookup, table, STIRLING, degree, index, coefficients);
+  return evaluate_plan_coefficients(STIRLING, degree, coefficients, (xinput - streaming_abscissa(table, index)) / table->h_width);
+}
+
+// NODES A STENCIL OF THE GIVEN FORMULA AND DEGREE SPANS
+static unsigned int stencil_size(const struct PiecewiseInterpolator* interpolator) {
+  const unsigned int degree = interpolator->degree;
+  if (!interpolator->uniform)
+    return degree + 1;
+  switch (interpolator->formula) {
+    case STIRLING:
+      return 2 * ((degree + 1) / 2) + 1;
+    case EVERETT:
+      return 2 * (degree / 2) + 2;
+    default:
+      return degree + 1;
+  }
+}
+
+struct PiecewiseInterpolator* new_piecewise_interpolator(const double* xval, const double* fval, const unsigned int npoints, const struct DifferenceTable* table, const enum InterpolationFormula formula, const unsigned int degree) {
+  struct PiecewiseInterpolator* interpolator = malloc(sizeof(struct PiecewiseInterpolator));
+  interpolator->xval = xval;
+  interpolator->fval = fval;
+  interpolator->npoints = npoints;
+  interpolator->formula = formula;
+  interpolator->degree = degree;
+  interpolator->x0 = npoints ? xval[0] : 0;
+  interpolator->h_width = (npoints > 1) ? (xval[npoints - 1] - xval[0]) / (npoints - 1) : 0;
+  interpolator->uniform = interpolator->h_width > 0;
+  for (unsigned int i = 0; i < npoints && interpolator->uniform; i++) {
+    const double expected = interpolator->x0 + i * interpolator->h_width;
+    if (fabs(xval[i] - expected) > 8 * DBL_EPSILON * fmax(fabs(xval[i]), interpolator->h_width * npoints))
+      interpolator->uniform = false;
+  }
+  if (npoints < 2 || stencil_size(interpolator) > npoints) {
+    fprintf(stderr, "ERROR: Invalid degree provided\n");
+    exit(1);
+  }
+  // THE INTERVAL SEARCH (AND h_width > 0 ON UNIFORM GRIDS) RELIES ON ASCENDING NODES
+  for (unsigned int i = 1; i < npoints; i++) {
+    if (!(xval[i] > xval[i - 1])) {
+      fprintf(stderr, "ERROR: Nodes must be strictly increasing\n");
+      exit(1);
+    }
+  }
+  interpolator->ownedTable = NULL;
+  interpolator->table = table;
+  if (interpolator->uniform && (!table || table->degree < degree)) {
+    interpolator->ownedTable = new_difference_table_degree(fval, npoints, degree);
+    interpolator->table = interpolator->ownedTable;
+  }
+  return interpolator;
+}
+
+void destroy_piecewise_interpolator(struct PiecewiseInterpolator* interpolator) {
+  if (!interpolator)
+    return;
+  destroy_difference_table(interpolator->ownedTable);
+  free(interpolator);
+}
+
+// INDEX j OF THE INTERVAL [x_j, x_(j + 1)] HOLDING x, CLAMPED TO THE TABLE
+// A NaN x FAILS EVERY COMPARISON, SO IT IS SENT TO INTERVAL 0 (AND EVALUATES TO NaN) RATHER
+// THAN REACHING THE CONVERSION TO unsigned int
+static unsigned int locate_interval(const struct PiecewiseInterpolator* interpolator, const double x) {
+  const unsigned int last = interpolator->npoints - 2;
+  if (interpolator->uniform) {
+    const double t = floor((x - interpolator->x0) / interpolator->h_width);
+    return !(t > 0) ? 0 : (t >= last) ? last : (unsigned int) t;
+  }
+  unsigned int low = 0, high = last;
+  while (low < high) {
+    const unsigned int mid = low + (high - low + 1) / 2;
+    if (interpolator->xval[mid] <= x)
+      low = mid;
+    else
+      high = mid - 1;
+  }
+  return low;
+}
+
+static unsigned int clamp_index(const long index, const long low, const long high) {
+  return (unsigned int) ((index < low) ? low : (index > high) ? high : index);
+}
+
+// BASE NODE OF THE STENCIL FOR A QUERY x IN INTERVAL j
+static unsigned int stencil_base(const struct PiecewiseInterpolator* interpolator, const unsigned int j, const double x) {
+  const long n = interpolator->npoints;
+  const long d = interpolator->degree;
+  const long start = clamp_index((long) j - (d - 1) / 2, 0, n - 1 - d);
+  if (!interpolator->uniform)
+    return (unsigned int) start;
+  switch (interpolator->formula) {
+    case NEWTON_ASCENDING:
+      return (unsigned int) start;
+    case NEWTON_DESCENDING:
+      return (unsigned int) (start + d);
+    case STIRLING: {
+      const long half = (d + 1) / 2;
+      const long nearest = (x - interpolator->xval[j] > interpolator->xval[j + 1] - x) ? (long) j + 1 : (long) j;
+      return clamp_index(nearest, half, n - 1 - half);
+    }
+    case EVERETT:
+      return clamp_index(j, d / 2, n - 2 - d / 2);
+  }
+  return (unsigned int) start;
+}
+
+// PREPARES coefficients FOR THE STENCIL AT base: PLAN COEFFICIENTS ON UNIFORM GRIDS, OR THE
+// BARYCENTRIC WEIGHTS OF THE STENCIL NODES OTHERWISE
+static void prepare_stencil(const struct PiecewiseInterpolator* interpolator, const unsigned int base, double* coefficients) {
+  if (interpolator->uniform) {
+    const struct TableSource source = { interpolator->table, interpolator->fval };
+    fill_plan_coefficients(table_lookup, &source, interpolator->formula, interpolator->degree, base, coefficients);
+    return;
+  }
+  const double* x = interpolator->xval + base;
+  for (unsigned int j = 0; j <= interpolator->degree; j++) {
+    double product = 1;
+    for (unsigned int k = 0; k <= interpolator->degree; k++) {
+      if (k != j)
+        product *= x[j] - x[k];
+    }
+    coefficients[j] = 1 / product;
+  }
+}
+
+static double evaluate_stencil(const struct PiecewiseInterpolator* interpolator, const unsigned int base, const double* coefficients, const double xinput) {
+  if (interpolator->uniform)
+    return evaluate_plan_coefficients(interpolator->formula, interpolator->degree, coefficients, (xinput - interpolator->xval[base]) / interpolator->h_width);
+  const double* x = interpolator->xval + base;
+  const double* f = interpolator->fval + base;
+  double numerator = 0, denominator = 0;
+  for (unsigned int j = 0; j <= interpolator->degree; j++) {
+    const double d = xinput - x[j];
+    if (d == 0)
+      return f[j];
+    const double t = coefficients[j] / d;
+    numerator += t * f[j];
+    denominator += t;
+  }
+  return numerator / denominator;
+}
+
+static unsigned int stencil_coefficient_count(const struct PiecewiseInterpolator* interpolator) {
+  return interpolator->uniform ? plan_size(interpolator->formula, interpolator->degree) : interpolator->degree + 1;
+}
+
+double piecewise_interpolate(const struct PiecewiseInterpolator* interpolator, const double xinput) {
+  double coefficients[stencil_coefficient_count(interpolator)];
+  const unsigned int base = stencil_base(interpolator, locate_interval(interpolator, xinput), xinput);
+  prepare_stencil(interpolator, base, coefficients);
+  return evaluate_stencil(interpolator, base, coefficients, xinput);
+}
+
+void piecewise_interpolate_sorted(const struct PiecewiseInterpolator* interpolator, const double* xinput, double* output, const unsigned int ninputs) {
+  if (!ninputs)
+    return;
+  double coefficients[stencil_coefficient_count(interpolator)];
+  const unsigned int last = interpolator->npoints - 2;
+  unsigned int j = locate_interval(interpolator, xinput[0]);
+  unsigned int base = interpolator->npoints;
+  for (unsigned int q = 0; q < ninputs; q++) {
+    const double x = xinput[q];
+    if (interpolator->uniform)
+      j = locate_interval(interpolator, x);
+    else
+      while (j < last && x >= interpolator->xval[j + 1])
+        j++;
+    const unsigned int nextBase = stencil_base(interpolator, j, x);
+    if (nextBase != base) {
+      base = nextBase;
+      prepare_stencil(interpolator, base, coefficients);
+    }
+    output[q] = evaluate_stencil(interpolator, base, coefficients, x);
   }
-  return polyVal;
 }
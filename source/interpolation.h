@@ -22,6 +22,10 @@ double lagrange(const double xinput, const double* xval, const double* fval, con
 
 double aitken(const double xinput, const double* xval, const double* fval, const unsigned int npoints);
 
+// THE *2 FORMS TAKE THEIR DIFFERENCE TABLE FROM THE SHARED CACHE OF tablecache.h
+// EVERY NODE THE FORMULA READS AROUND index MUST BE IN THE TABLE: index - degree .. index
+// (DESCENDING), index -+ (degree + 1) / 2 (STIRLING), index - degree / 2 .. index + 1 +
+// degree / 2 (EVERETT). ANYTHING ELSE IS REPORTED AS AN INVALID DEGREE
 double newton_ascending(const struct DifferenceTable* table, const double xinput, const double* xval, const double* fval, const unsigned int degree, const double h_width, const  unsigned int npoints);
 
 double newton_ascending2(const double xinput, const double* xval, const double* fval, const unsigned int degree, const double h_width, const  unsigned int npoints);
@@ -38,4 +42,97 @@ double everett(const struct DifferenceTable* differenceTable, const double xinpu
 
 double everett2(const double xinput, const unsigned int index, const double* xval, const double* fval, const unsigned int degree, const double h_width, const unsigned int npoints);
 
+enum InterpolationFormula {
+  NEWTON_ASCENDING,
+  NEWTON_DESCENDING,
+  STIRLING,
+  EVERETT
+};
+
+// COMPILED FORM OF ONE FINITE-DIFFERENCE FORMULA AT ONE BASE INDEX
+// THE DIFFERENCES AND FACTORIALS ARE GATHERED ONCE, SO EACH EVALUATION IS A NESTED
+// PRODUCT OF O(degree) LINEAR FACTORS WITH NO CALLS TO tgamma
+struct InterpolationPlan {
+  enum InterpolationFormula formula;
+  unsigned int degree;
+  double x0;
+  double h_width;
+  double* coefficients;
+};
+
+// s IS MEASURED FROM xval[index] (index 0 GIVES newton_ascending, WHICH ALWAYS USES THE FIRST NODE)
+// THE STENCIL AROUND index MUST LIE IN THE TABLE AS FOR THE FORMULAS ABOVE (index .. index +
+// degree FOR NEWTON_ASCENDING), OTHERWISE AN INVALID DEGREE IS REPORTED
+struct InterpolationPlan* new_interpolation_plan(const struct DifferenceTable* table, const double* xval, const double* fval, const enum InterpolationFormula formula, const unsigned int degree, const unsigned int index, const double h_width);
+
+void destroy_interpolation_plan(struct InterpolationPlan* plan);
+
+double interpolation_plan_eval(const struct InterpolationPlan* plan, const double xinput);
+
+void interpolation_plan_batch(const struct InterpolationPlan* plan, const double* xinput, double* output, const unsigned int ninputs);
+
+// NEWTON'S DESCENDING FORMULA FROM THE NEWEST SAMPLE OF A STREAMING TABLE
+double newton_descending_streaming(const struct StreamingDifferenceTable* table, const double xinput, const unsigned int degree);
+
+// STIRLING'S FORMULA ABOUT THE NEWEST SAMPLE WITH A FULL CENTRED STENCIL, (degree + 1) / 2
+// SAMPLES BEHIND THE NEWEST ONE
+double stirling_streaming(const struct StreamingDifferenceTable* table, const double xinput, const unsigned int degree);
+
+// PIECEWISE LOCAL INTERPOLATION OVER ONE LARGE TABLE
+// FOR EACH QUERY THE ENGINE LOCATES THE ENCLOSING INTERVAL (O(1) ON UNIFORM GRIDS, BINARY
+// SEARCH OTHERWISE), PICKS A CENTRED STENCIL OF THE REQUESTED DEGREE, CLAMPED AT THE EDGES
+// OF THE TABLE, AND APPLIES formula. NON-UNIFORM GRIDS FALL BACK TO THE LAGRANGE POLYNOMIAL
+// OF THE STENCIL. table MAY BE NULL, IN WHICH CASE THE DIFFERENCES ARE BUILT AND OWNED
+// xval MUST BE STRICTLY INCREASING (ANYTHING ELSE IS REPORTED AS AN ERROR)
+struct PiecewiseInterpolator {
+  const double* xval;
+  const double* fval;
+  unsigned int npoints;
+  const struct DifferenceTable* table;
+  struct DifferenceTable* ownedTable;
+  enum InterpolationFormula formula;
+  unsigned int degree;
+  bool uniform;
+  double x0;
+  double h_width;
+};
+
+struct PiecewiseInterpolator* new_piecewise_interpolator(const double* xval, const double* fval, const unsigned int npoints, const struct DifferenceTable* table, const enum InterpolationFormula formula, const unsigned int degree);
+
+void destroy_piecewise_interpolator(struct PiecewiseInterpolator* interpolator);
+
+double piecewise_interpolate(const struct PiecewiseInterpolator* interpolator, const double xinput);
+
+// xinput MUST BE SORTED IN ASCENDING ORDER: THE INTERVAL IS FOUND BY ADVANCING A CURSOR AND
+// THE STENCIL COEFFICIENTS ARE REUSED WHILE CONSECUTIVE QUERIES SHARE A BASE NODE
+void piecewise_interpolate_sorted(const struct PiecewiseInterpolator* interpolator, const double* xinput, double* output, const unsigned int ninputs);
+
+// BARYCENTRIC FORM OF THE LAGRANGE POLYNOMIAL THROUGH (xval[j], fval[j])
+// THE WEIGHTS ARE COMPUTED ONCE (O(n^2) FOR ARBITRARY NODES, O(n) FOR EQUISPACED AND
+// CHEBYSHEV NODES), AFTER WHICH EACH EVALUATION COSTS O(n)
+struct BarycentricInterpolant {
+  double* xval;
+  double* fval;
+  double* weights;
+  unsigned int npoints;
+  unsigned int capacity;
+};
+
+struct BarycentricInterpolant* new_barycentric(const double* xval, const double* fval, const unsigned int npoints);
+
+// NODES x0 + j * h_width
+struct BarycentricInterpolant* new_barycentric_equispaced(const double x0, const double h_width, const double* fval, const unsigned int npoints);
+
+// CHEBYSHEV POINTS OF THE SECOND KIND ON [a, b], ORDERED FROM b DOWN TO a
+struct BarycentricInterpolant* new_barycentric_chebyshev(const double a, const double b, const double* fval, const unsigned int npoints);
+
+void destroy_barycentric(struct BarycentricInterpolant* interpolant);
+
+// ADDS THE NODE (xnew, fnew) AND UPDATES THE WEIGHTS IN O(n)
+void barycentric_add_node(struct BarycentricInterpolant* interpolant, const double xnew, const double fnew);
+
+double barycentric(const struct BarycentricInterpolant* interpolant, const double xinput);
+
+void barycentric_batch(const struct BarycentricInterpolant* interpolant, const double* xinput, double* output, const unsigned int ninputs);
+
 #endif /* interpolation_h */
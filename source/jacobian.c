@@ -0,0 +1,257 @@
+//
+//  jacobian.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "jacobian.h"
+#include "matrixkernels.h"
+#include "definitions.h"
+
+struct SparsityPattern* new_sparsity_pattern(const unsigned int nrows, const unsigned int ncols, const unsigned int* rowStart, const unsigned int* columns) {
+  struct SparsityPattern* pattern = malloc(sizeof(struct SparsityPattern));
+  const unsigned int nnz = rowStart[nrows];
+  pattern->nrows = nrows;
+  pattern->ncols = ncols;
+  pattern->rowStart = malloc((nrows + 1) * sizeof(unsigned int));
+  pattern->columns = malloc((nnz + 1) * sizeof(unsigned int));
+  memcpy(pattern->rowStart, rowStart, (nrows + 1) * sizeof(unsigned int));
+  memcpy(pattern->columns, columns, nnz * sizeof(unsigned int));
+  for (unsigned int k = 0; k < nnz; k++) {
+    if (columns[k] >= ncols) {
+      fprintf(stderr, "ERROR: Sparsity pattern column out of range\n");
+      exit(1);
+    }
+  }
+  return pattern;
+}
+
+void destroy_sparsity_pattern(struct SparsityPattern* pattern) {
+  if (!pattern)
+    return;
+  free(pattern->rowStart);
+  free(pattern->columns);
+  free(pattern);
+}
+
+struct SparseMatrix* new_sparse_matrix(const struct SparsityPattern* pattern) {
+  struct SparseMatrix* m = malloc(sizeof(struct SparseMatrix));
+  m->pattern = pattern;
+  m->values = calloc(pattern->rowStart[pattern->nrows] + 1, sizeof(double));
+  return m;
+}
+
+void destroy_sparse_matrix(struct SparseMatrix* m) {
+  if (!m)
+    return;
+  free(m->values);
+  free(m);
+}
+
+// BUILDS THE COLUMN-WISE (CSC) VIEW OF THE PATTERN, REMEMBERING WHERE EACH ENTRY SITS IN
+// THE ROW-WISE ORDER
+static void transpose_pattern(struct JacobianEstimator* est) {
+  const struct SparsityPattern* p = est->pattern;
+  const unsigned int nnz = p->rowStart[p->nrows];
+  est->columnStart = calloc(p->ncols + 1, sizeof(unsigned int));
+  est->columnRows = malloc((nnz + 1) * sizeof(unsigned int));
+  est->columnEntries = malloc((nnz + 1) * sizeof(unsigned int));
+  for (unsigned int k = 0; k < nnz; k++)
+    est->columnStart[p->columns[k] + 1]++;
+  for (unsigned int j = 0; j < p->ncols; j++)
+    est->columnStart[j + 1] += est->columnStart[j];
+  unsigned int* next = malloc((p->ncols + 1) * sizeof(unsigned int));
+  memcpy(next, est->columnStart, (p->ncols + 1) * sizeof(unsigned int));
+  for (unsigned int i = 0; i < p->nrows; i++) {
+    for (unsigned int k = p->rowStart[i]; k < p->rowStart[i + 1]; k++) {
+      const unsigned int slot = next[p->columns[k]]++;
+      est->columnRows[slot] = i;
+      est->columnEntries[slot] = k;
+    }
+  }
+  free(next);
+}
+
+// GREEDY DISTANCE-2 COLOURING: A COLUMN TAKES THE SMALLEST COLOUR NOT USED BY ANY COLUMN
+// IT SHARES A ROW WITH
+static void colour_columns(struct JacobianEstimator* est) {
+  const unsigned int n = est->dimension;
+  unsigned int* colour = malloc((n + 1) * sizeof(unsigned int));
+  unsigned int* forbidden = malloc((n + 1) * sizeof(unsigned int));
+  est->ncolours = 0;
+  if (!est->pattern) {
+    for (unsigned int j = 0; j < n; j++)
+      colour[j] = j;
+    est->ncolours = n;
+  } else {
+    const struct SparsityPattern* p = est->pattern;
+    for (unsigned int c = 0; c <= n; c++)
+      forbidden[c] = n;
+    for (unsigned int j = 0; j < n; j++) {
+      for (unsigned int k = est->columnStart[j]; k < est->columnStart[j + 1]; k++) {
+        const unsigned int i = est->columnRows[k];
+        for (unsigned int l = p->rowStart[i]; l < p->rowStart[i + 1]; l++) {
+          if (p->columns[l] < j)
+            forbidden[colour[p->columns[l]]] = j;
+        }
+      }
+      unsigned int c = 0;
+      while (forbidden[c] == j)
+        c++;
+      colour[j] = c;
+      if (c + 1 > est->ncolours)
+        est->ncolours = c + 1;
+    }
+  }
+  est->colourStart = calloc(est->ncolours + 1, sizeof(unsigned int));
+  est->colourColumns = malloc((n + 1) * sizeof(unsigned int));
+  for (unsigned int j = 0; j < n; j++)
+    est->colourStart[colour[j] + 1]++;
+  for (unsigned int c = 0; c < est->ncolours; c++)
+    est->colourStart[c + 1] += est->colourStart[c];
+  memcpy(forbidden, est->colourStart, est->ncolours * sizeof(unsigned int));
+  for (unsigned int j = 0; j < n; j++)
+    est->colourColumns[forbidden[colour[j]]++] = j;
+  free(colour);
+  free(forbidden);
+}
+
+struct JacobianEstimator* new_jacobian_estimator(const multivariate_function f, const unsigned int dimension, const struct SparsityPattern* pattern, const unsigned int nthreads) {
+  if (pattern && (pattern->nrows != dimension || pattern->ncols != dimension)) {
+    fprintf(stderr, "ERROR: Sparsity pattern does not match the system dimension\n");
+    exit(1);
+  }
+  struct JacobianEstimator* est = malloc(sizeof(struct JacobianEstimator));
+  est->f = f;
+  est->dimension = dimension;
+  est->pattern = pattern;
+  est->columnStart = NULL;
+  est->columnRows = NULL;
+  est->columnEntries = NULL;
+  if (pattern)
+    transpose_pattern(est);
+  colour_columns(est);
+  est->nthreads = nthreads ? nthreads : get_matrix_threads();
+  if (est->nthreads > est->ncolours)
+    est->nthreads = est->ncolours ? est->ncolours : 1;
+  est->scratch = malloc(((size_t) (2 * est->nthreads + 1) * dimension + 1) * sizeof(double));
+  return est;
+}
+
+void destroy_jacobian_estimator(struct JacobianEstimator* estimator) {
+  if (!estimator)
+    return;
+  free(estimator->columnStart);
+  free(estimator->columnRows);
+  free(estimator->columnEntries);
+  free(estimator->colourStart);
+  free(estimator->colourColumns);
+  free(estimator->scratch);
+  free(estimator);
+}
+
+struct JacobianTask {
+  struct JacobianEstimator* est;
+  const double* x;
+  const double* fx;
+  struct Matrix* dense;
+  double* values;
+  unsigned int thread;
+};
+
+static void* jacobian_thread(void* ptr) {
+  const struct JacobianTask* task = ptr;
+  const struct JacobianEstimator* est = task->est;
+  const unsigned int n = est->dimension;
+  const double* x = task->x;
+  double* xp = est->scratch + (size_t) 2 * n * task->thread;
+  double* fp = xp + n;
+  const double root = sqrt(DBL_EPSILON);
+  memcpy(xp, x, n * sizeof(double));
+  for (unsigned int c = task->thread; c < est->ncolours; c += est->nthreads) {
+    for (unsigned int k = est->colourStart[c]; k < est->colourStart[c + 1]; k++) {
+      const unsigned int j = est->colourColumns[k];
+      xp[j] = x[j] + root * fmax(fabs(x[j]), 1.0);
+    }
+    est->f(xp, fp);
+    for (unsigned int k = est->colourStart[c]; k < est->colourStart[c + 1]; k++) {
+      const unsigned int j = est->colourColumns[k];
+      const double h = xp[j] - x[j];
+      xp[j] = x[j];
+      if (!est->pattern) {
+        for (unsigned int i = 0; i < n; i++)
+          *matrix_element(task->dense, i, j) = (fp[i] - task->fx[i]) / h;
+        continue;
+      }
+      for (unsigned int l = est->columnStart[j]; l < est->columnStart[j + 1]; l++) {
+        const unsigned int i = est->columnRows[l];
+        const double val = (fp[i] - task->fx[i]) / h;
+        if (task->dense)
+          *matrix_element(task->dense, i, j) = val;
+        else
+          task->values[est->columnEntries[l]] = val;
+      }
+    }
+  }
+  return NULL;
+}
+
+static unsigned int run_jacobian(struct JacobianEstimator* est, const double* x, const double* fx, struct Matrix* dense, double* values) {
+  unsigned int calls = est->ncolours;
+  if (!fx) {
+    double* f0 = est->scratch + (size_t) 2 * est->dimension * est->nthreads;
+    est->f(x, f0);
+    fx = f0;
+    calls++;
+  }
+  const unsigned int nthreads = est->nthreads;
+  struct JacobianTask tasks[nthreads];
+  pthread_t threads[nthreads];
+  for (unsigned int t = 0; t < nthreads; t++) {
+    struct JacobianTask task = { est, x, fx, dense, values, t };
+    tasks[t] = task;
+  }
+  if (nthreads == 1) {
+    jacobian_thread(&tasks[0]);
+    return calls;
+  }
+  unsigned int t = 1;
+  for (; t < nthreads; t++) {
+    if (pthread_create(&threads[t], NULL, jacobian_thread, &tasks[t]))
+      break;
+  }
+  jacobian_thread(&tasks[0]);
+  for (unsigned int u = 1; u < t; u++)
+    pthread_join(threads[u], NULL);
+  for (; t < nthreads; t++)
+    jacobian_thread(&tasks[t]);
+  return calls;
+}
+
+unsigned int estimate_jacobian(struct JacobianEstimator* estimator, const double* x, const double* fx, struct Matrix* J) {
+  if (J->nrows != estimator->dimension || J->ncols != estimator->dimension) {
+    fprintf(stderr, "ERROR: Matrix dimensions do not match\n");
+    exit(1);
+  }
+  if (estimator->pattern)
+    matrix_fill(J, 0.0);
+  return run_jacobian(estimator, x, fx, J, NULL);
+}
+
+unsigned int estimate_jacobian_sparse(struct JacobianEstimator* estimator, const double* x, const double* fx, struct SparseMatrix* J) {
+  if (!estimator->pattern || J->pattern != estimator->pattern) {
+    fprintf(stderr, "ERROR: Sparse Jacobian requires the estimator's sparsity pattern\n");
+    exit(1);
+  }
+  return run_jacobian(estimator, x, fx, NULL, J->values);
+}
@@ -0,0 +1,68 @@
+//
+//  jacobian.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef jacobian_h
+#define jacobian_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// COMPRESSED SPARSE ROW PATTERN: THE NONZEROS OF ROW i LIE IN COLUMNS
+// columns[rowStart[i]] ... columns[rowStart[i + 1] - 1]
+struct SparsityPattern {
+  unsigned int nrows;
+  unsigned int ncols;
+  unsigned int* rowStart;
+  unsigned int* columns;
+};
+
+// VALUES OF A MATRIX WITH A GIVEN PATTERN, ONE PER NONZERO IN PATTERN ORDER
+struct SparseMatrix {
+  const struct SparsityPattern* pattern;
+  double* values;
+};
+
+struct SparsityPattern* new_sparsity_pattern(const unsigned int nrows, const unsigned int ncols, const unsigned int* rowStart, const unsigned int* columns);
+
+void destroy_sparsity_pattern(struct SparsityPattern* pattern);
+
+struct SparseMatrix* new_sparse_matrix(const struct SparsityPattern* pattern);
+
+void destroy_sparse_matrix(struct SparseMatrix* m);
+
+// FORWARD-DIFFERENCE JACOBIAN ESTIMATOR FOR f : R^dimension -> R^dimension
+// COLUMNS THAT SHARE NO ROW OF THE PATTERN GET THE SAME COLOUR AND ARE PERTURBED TOGETHER,
+// SO EACH ESTIMATE COSTS ONE f CALL PER COLOUR (dimension CALLS WITHOUT A PATTERN).
+// WITH nthreads > 1 THE COLOURS ARE SPLIT ACROSS THREADS, EACH WITH ITS OWN SCRATCH
+// BUFFERS (2 * dimension PER THREAD), SO f MUST THEN BE SAFE TO CALL CONCURRENTLY. nthreads == 0 USES ONE PER CPU
+struct JacobianEstimator {
+  multivariate_function f;
+  unsigned int dimension;
+  const struct SparsityPattern* pattern;
+  unsigned int* columnStart;
+  unsigned int* columnRows;
+  unsigned int* columnEntries;
+  unsigned int ncolours;
+  unsigned int* colourStart;
+  unsigned int* colourColumns;
+  unsigned int nthreads;
+  double* scratch;
+};
+
+struct JacobianEstimator* new_jacobian_estimator(const multivariate_function f, const unsigned int dimension, const struct SparsityPattern* pattern, const unsigned int nthreads);
+
+void destroy_jacobian_estimator(struct JacobianEstimator* estimator);
+
+// fx MAY HOLD f(x) ALREADY; OTHERWISE PASS NULL AND IT IS EVALUATED (ONE EXTRA CALL)
+// BOTH RETURN THE NUMBER OF f CALLS MADE
+unsigned int estimate_jacobian(struct JacobianEstimator* estimator, const double* x, const double* fx, struct Matrix* J);
+
+unsigned int estimate_jacobian_sparse(struct JacobianEstimator* estimator, const double* x, const double* fx, struct SparseMatrix* J);
+
+#endif /* jacobian_h */
@@ -0,0 +1,145 @@
+//
+//  linearsystems.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "linearsystems.h"
+#include "matrixkernels.h"
+#include "definitions.h"
+
+static void swap_rows(struct Matrix* A, const unsigned int r1, const unsigned int r2) {
+  if (r1 == r2)
+    return;
+  for (unsigned int j = 0; j < A->ncols; j++) {
+    double* a = matrix_element(A, r1, j);
+    double* b = matrix_element(A, r2, j);
+    const double tmp = *a;
+    *a = *b;
+    *b = tmp;
+  }
+}
+
+// UNBLOCKED FACTORISATION OF THE PANEL OF COLUMNS [k, k + nb) OVER ROWS [k, n)
+// PIVOT ROWS ARE SWAPPED ACROSS THE FULL WIDTH OF A
+static bool lu_factor_panel(struct Matrix* A, unsigned int* pivots, const unsigned int k, const unsigned int nb) {
+  const unsigned int n = A->nrows;
+  bool regular = true;
+  for (unsigned int j = k; j < k + nb; j++) {
+    unsigned int pivot = j;
+    double largest = fabs(*matrix_element(A, j, j));
+    for (unsigned int i = j + 1; i < n; i++) {
+      if (fabs(*matrix_element(A, i, j)) > largest) {
+        largest = fabs(*matrix_element(A, i, j));
+        pivot = i;
+      }
+    }
+    pivots[j] = pivot;
+    swap_rows(A, j, pivot);
+    if (largest == 0) {
+      regular = false;
+      continue;
+    }
+    const double inverse = 1.0 / *matrix_element(A, j, j);
+    for (unsigned int i = j + 1; i < n; i++) {
+      double* lij = matrix_element(A, i, j);
+      *lij *= inverse;
+      for (unsigned int c = j + 1; c < k + nb; c++)
+        *matrix_element(A, i, c) -= *lij * *matrix_element(A, j, c);
+    }
+  }
+  return regular;
+}
+
+bool lu_factor(struct Matrix* A, unsigned int* pivots) {
+  if (A->nrows != A->ncols) {
+    fprintf(stderr, "ERROR: LU factorisation requires a square matrix\n");
+    exit(1);
+  }
+  const unsigned int n = A->nrows;
+  bool regular = true;
+  for (unsigned int k = 0; k < n; k += LU_BLOCK_SIZE) {
+    const unsigned int nb = (n - k < LU_BLOCK_SIZE) ? n - k : LU_BLOCK_SIZE;
+    regular = lu_factor_panel(A, pivots, k, nb) && regular;
+    const unsigned int rest = n - k - nb;
+    if (!rest)
+      break;
+    // U12 = L11^-1 A12 (UNIT LOWER TRIANGULAR SOLVE ON THE BLOCK ROW)
+    for (unsigned int i = k + 1; i < k + nb; i++) {
+      for (unsigned int p = k; p < i; p++) {
+        const double lip = *matrix_element(A, i, p);
+        double* ui = matrix_element(A, i, k + nb);
+        const double* up = matrix_element(A, p, k + nb);
+        for (unsigned int c = 0; c < rest; c++)
+          ui[(size_t) c * A->colStride] -= lip * up[(size_t) c * A->colStride];
+      }
+    }
+    // A22 -= L21 U12
+    const struct Matrix L21 = matrix_submatrix(A, k + nb, k, rest, nb);
+    const struct Matrix U12 = matrix_submatrix(A, k, k + nb, nb, rest);
+    struct Matrix A22 = matrix_submatrix(A, k + nb, k + nb, rest, rest);
+    matrix_gemm(-1.0, &L21, &U12, 1.0, &A22);
+  }
+  return regular;
+}
+
+void lu_solve(const struct Matrix* LU, const unsigned int* pivots, double* b) {
+  const unsigned int n = LU->nrows;
+  for (unsigned int i = 0; i < n; i++) {
+    if (pivots[i] != i) {
+      const double tmp = b[i];
+      b[i] = b[pivots[i]];
+      b[pivots[i]] = tmp;
+    }
+  }
+  for (unsigned int i = 1; i < n; i++) {
+    const double* l = matrix_element(LU, i, 0);
+    double val = b[i];
+    for (unsigned int j = 0; j < i; j++)
+      val -= l[(size_t) j * LU->colStride] * b[j];
+    b[i] = val;
+  }
+  for (unsigned int i = n; i-- > 0;) {
+    const double* u = matrix_element(LU, i, 0);
+    double val = b[i];
+    for (unsigned int j = i + 1; j < n; j++)
+      val -= u[(size_t) j * LU->colStride] * b[j];
+    b[i] = val / u[(size_t) i * LU->colStride];
+  }
+}
+
+void lu_solve_many(const struct Matrix* LU, const unsigned int* pivots, struct Matrix* B) {
+  const unsigned int n = LU->nrows;
+  if (B->nrows != n) {
+    fprintf(stderr, "ERROR: Matrix dimensions do not match\n");
+    exit(1);
+  }
+  for (unsigned int i = 0; i < n; i++)
+    swap_rows(B, i, pivots[i]);
+  // ROW-ORIENTED SUBSTITUTIONS: EACH UPDATE IS AN AXPY OVER A ROW OF B
+  for (unsigned int i = 1; i < n; i++) {
+    for (unsigned int j = 0; j < i; j++) {
+      const double lij = *matrix_element(LU, i, j);
+      for (unsigned int c = 0; c < B->ncols; c++)
+        *matrix_element(B, i, c) -= lij * *matrix_element(B, j, c);
+    }
+  }
+  for (unsigned int i = n; i-- > 0;) {
+    for (unsigned int j = i + 1; j < n; j++) {
+      const double uij = *matrix_element(LU, i, j);
+      for (unsigned int c = 0; c < B->ncols; c++)
+        *matrix_element(B, i, c) -= uij * *matrix_element(B, j, c);
+    }
+    const double inverse = 1.0 / *matrix_element(LU, i, i);
+    for (unsigned int c = 0; c < B->ncols; c++)
+      *matrix_element(B, i, c) *= inverse;
+  }
+}
@@ -0,0 +1,29 @@
+//
+//  linearsystems.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef linearsystems_h
+#define linearsystems_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// COLUMNS PER PANEL OF THE BLOCKED FACTORISATION
+#define LU_BLOCK_SIZE 64
+
+// IN-PLACE LU FACTORISATION WITH PARTIAL PIVOTING (PA = LU, L UNIT LOWER TRIANGULAR)
+// ROW i WAS SWAPPED WITH ROW pivots[i] AT STEP i. RETURNS false IF A IS SINGULAR
+bool lu_factor(struct Matrix* A, unsigned int* pivots);
+
+// SOLVES A x = b IN PLACE (b IS OVERWRITTEN WITH x) USING THE OUTPUT OF lu_factor
+void lu_solve(const struct Matrix* LU, const unsigned int* pivots, double* b);
+
+// SOLVES A X = B IN PLACE FOR EVERY COLUMN OF B
+void lu_solve_many(const struct Matrix* LU, const unsigned int* pivots, struct Matrix* B);
+
+#endif /* linearsystems_h */
@@ -0,0 +1,225 @@
+//
+//  matrixkernels.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "matrixkernels.h"
+#include "definitions.h"
+
+// REGISTER TILE (MR x NR), L1 PANEL DEPTH (KC) AND L2/L3 BLOCK SIZES (MC, NC)
+#define GEMM_MR 4
+#define GEMM_NR 8
+#define GEMM_KC 256
+#define GEMM_MC 32
+#define GEMM_NC 512
+
+static unsigned int matrixThreads = 0;
+
+void set_matrix_threads(const unsigned int nthreads) {
+  matrixThreads = nthreads;
+}
+
+unsigned int get_matrix_threads(void) {
+  if (!matrixThreads) {
+    const long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    matrixThreads = ncpus > 0 ? (unsigned int) ncpus : 1;
+  }
+  return matrixThreads;
+}
+
+static void scale_matrix(struct Matrix* C, const double beta) {
+  if (beta == 1.0)
+    return;
+  if (beta == 0.0) {
+    matrix_fill(C, 0.0);
+    return;
+  }
+  for (unsigned int i = 0; i < C->nrows; i++)
+    for (unsigned int j = 0; j < C->ncols; j++)
+      *matrix_element(C, i, j) *= beta;
+}
+
+// COPIES THE kc x nr PANEL OF B STARTING AT b INTO bpack, ROW BY ROW AND PADDED WITH ZEROS
+// TO GEMM_NR COLUMNS, SO THE MICRO-KERNEL ALWAYS READS CONTIGUOUS, FULL-WIDTH ROWS
+static void pack_b_panel(const double* b, const size_t bRow, const size_t bCol, const unsigned int kc, const unsigned int nr, double* bpack) {
+  for (unsigned int p = 0; p < kc; p++) {
+    unsigned int j = 0;
+    for (; j < nr; j++)
+      bpack[p * GEMM_NR + j] = b[p * bRow + j * bCol];
+    for (; j < GEMM_NR; j++)
+      bpack[p * GEMM_NR + j] = 0.0;
+  }
+}
+
+// COPIES THE mc x kc BLOCK OF A STARTING AT a INTO apack AS GEMM_MR-ROW MICRO-PANELS, EACH
+// STORED COLUMN BY COLUMN AND PADDED WITH ZEROS TO GEMM_MR ROWS
+static void pack_a_block(const double* a, const size_t aRow, const size_t aCol, const unsigned int mc, const unsigned int kc, double* apack) {
+  for (unsigned int ir = 0; ir < mc; ir += GEMM_MR) {
+    const unsigned int mr = (mc - ir < GEMM_MR) ? mc - ir : GEMM_MR;
+    double* panel = apack + (size_t) ir * kc;
+    for (unsigned int p = 0; p < kc; p++) {
+      unsigned int i = 0;
+      for (; i < mr; i++)
+        panel[p * GEMM_MR + i] = a[(ir + i) * aRow + p * aCol];
+      for (; i < GEMM_MR; i++)
+        panel[p * GEMM_MR + i] = 0.0;
+    }
+  }
+}
+
+// ACCUMULATES alpha * APACK(GEMM_MR x kc) * BPACK(kc x GEMM_NR) INTO THE mr x nr TILE OF C AT c
+// THE ACCUMULATOR TILE STAYS IN VECTOR REGISTERS AND THE j LOOP IS VECTORISED
+static inline void gemm_micro_kernel(const unsigned int mr, const unsigned int nr, const unsigned int kc, const double alpha, const double* apack, const double* bpack, double* c, const size_t cRow, const size_t cCol) {
+  double acc[GEMM_MR][GEMM_NR] = {{ 0 }};
+  for (unsigned int p = 0; p < kc; p++) {
+    const double* a = apack + p * GEMM_MR;
+    const double* b = bpack + p * GEMM_NR;
+    for (unsigned int i = 0; i < GEMM_MR; i++)
+      for (unsigned int j = 0; j < GEMM_NR; j++)
+        acc[i][j] += a[i] * b[j];
+  }
+  if (mr == GEMM_MR && nr == GEMM_NR && cCol == 1) {
+    for (unsigned int i = 0; i < GEMM_MR; i++)
+      for (unsigned int j = 0; j < GEMM_NR; j++)
+        c[i * cRow + j] += alpha * acc[i][j];
+    return;
+  }
+  for (unsigned int i = 0; i < mr; i++)
+    for (unsigned int j = 0; j < nr; j++)
+      c[i * cRow + j * cCol] += alpha * acc[i][j];
+}
+
+// C += alpha * A * B ON ONE THREAD
+// EACH kc x nc BLOCK OF B IS PACKED ONCE AND THEN SHARED BY EVERY mc-ROW BLOCK OF A. IT IS
+// UP TO GEMM_KC x GEMM_NC DOUBLES, TOO LARGE FOR A THREAD STACK, SO IT IS ALLOCATED PER CALL
+static void gemm_blocked(const double alpha, const struct Matrix* A, const struct Matrix* B, struct Matrix* C) {
+  double apack[GEMM_MC * GEMM_KC];
+  const unsigned int M = C->nrows, N = C->ncols, K = A->ncols;
+  const unsigned int kmax = (K < GEMM_KC) ? K : GEMM_KC;
+  const unsigned int nmax = (N < GEMM_NC) ? N : GEMM_NC;
+  double* bpack = malloc((size_t) kmax * ((nmax + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * sizeof(double));
+  for (unsigned int jc = 0; jc < N; jc += GEMM_NC) {
+    const unsigned int nc = (N - jc < GEMM_NC) ? N - jc : GEMM_NC;
+    for (unsigned int pc = 0; pc < K; pc += GEMM_KC) {
+      const unsigned int kc = (K - pc < GEMM_KC) ? K - pc : GEMM_KC;
+      for (unsigned int jr = 0; jr < nc; jr += GEMM_NR) {
+        const unsigned int nr = (nc - jr < GEMM_NR) ? nc - jr : GEMM_NR;
+        pack_b_panel(matrix_element(B, pc, jc + jr), B->rowStride, B->colStride, kc, nr, bpack + (size_t) jr * kc);
+      }
+      for (unsigned int ic = 0; ic < M; ic += GEMM_MC) {
+        const unsigned int mc = (M - ic < GEMM_MC) ? M - ic : GEMM_MC;
+        pack_a_block(matrix_element(A, ic, pc), A->rowStride, A->colStride, mc, kc, apack);
+        for (unsigned int jr = 0; jr < nc; jr += GEMM_NR) {
+          const unsigned int nr = (nc - jr < GEMM_NR) ? nc - jr : GEMM_NR;
+          for (unsigned int ir = 0; ir < mc; ir += GEMM_MR) {
+            const unsigned int mr = (mc - ir < GEMM_MR) ? mc - ir : GEMM_MR;
+            gemm_micro_kernel(mr, nr, kc, alpha, apack + (size_t) ir * kc, bpack + (size_t) jr * kc, matrix_element(C, ic + ir, jc + jr), C->rowStride, C->colStride);
+          }
+        }
+      }
+    }
+  }
+  free(bpack);
+}
+
+struct GemmTask {
+  double alpha;
+  struct Matrix A;
+  const struct Matrix* B;
+  struct Matrix C;
+};
+
+static void* gemm_thread(void* ptr) {
+  struct GemmTask* task = ptr;
+  gemm_blocked(task->alpha, &task->A, task->B, &task->C);
+  return NULL;
+}
+
+void matrix_gemm(const double alpha, const struct Matrix* A, const struct Matrix* B, const double beta, struct Matrix* C) {
+  if (A->ncols != B->nrows || C->nrows != A->nrows || C->ncols != B->ncols) {
+    fprintf(stderr, "ERROR: Matrix dimensions do not match\n");
+    exit(1);
+  }
+  scale_matrix(C, beta);
+  if (alpha == 0.0 || !A->ncols)
+    return;
+  // LARGE PRODUCTS ARE SPLIT INTO HORIZONTAL SLICES OF C, ONE PER THREAD
+  const double work = (double) C->nrows * C->ncols * A->ncols;
+  unsigned int nthreads = (work < MATRIX_THREAD_THRESHOLD) ? 1 : get_matrix_threads();
+  if (nthreads > C->nrows / GEMM_MR)
+    nthreads = C->nrows / GEMM_MR;
+  if (nthreads <= 1) {
+    gemm_blocked(alpha, A, B, C);
+    return;
+  }
+  struct GemmTask tasks[nthreads];
+  pthread_t threads[nthreads];
+  // ceil(nrows / nthreads) ROUNDED UP TO GEMM_MR, SO nthreads SLICES ALWAYS COVER EVERY ROW
+  const unsigned int slice = (((C->nrows + nthreads - 1) / nthreads + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+  unsigned int nstarted = 0;
+  for (unsigned int t = 0; t < nthreads; t++) {
+    const unsigned int row = t * slice;
+    if (row >= C->nrows)
+      break;
+    const unsigned int rows = (C->nrows - row < slice) ? C->nrows - row : slice;
+    tasks[t].alpha = alpha;
+    tasks[t].A = matrix_submatrix(A, row, 0, rows, A->ncols);
+    tasks[t].B = B;
+    tasks[t].C = matrix_submatrix(C, row, 0, rows, C->ncols);
+    nstarted++;
+  }
+  unsigned int t = 1;
+  for (; t < nstarted; t++) {
+    if (pthread_create(&threads[t], NULL, gemm_thread, &tasks[t]))
+      break;
+  }
+  gemm_thread(&tasks[0]);
+  for (unsigned int u = 1; u < t; u++)
+    pthread_join(threads[u], NULL);
+  // ANY SLICE WHOSE THREAD COULD NOT BE STARTED IS COMPUTED HERE
+  for (; t < nstarted; t++)
+    gemm_thread(&tasks[t]);
+}
+
+void matrix_gemv(const double alpha, const struct Matrix* A, const double* x, const double beta, double* y) {
+  const unsigned int M = A->nrows, N = A->ncols;
+  if (A->colStride == 1) {
+    // CONTIGUOUS ROWS: ONE DOT PRODUCT PER ROW WITH INDEPENDENT ACCUMULATORS
+    for (unsigned int i = 0; i < M; i++) {
+      const double* a = matrix_element(A, i, 0);
+      double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      unsigned int j = 0;
+      for (; j + 4 <= N; j += 4) {
+        s0 += a[j] * x[j];
+        s1 += a[j + 1] * x[j + 1];
+        s2 += a[j + 2] * x[j + 2];
+        s3 += a[j + 3] * x[j + 3];
+      }
+      for (; j < N; j++)
+        s0 += a[j] * x[j];
+      const double dot = (s0 + s1) + (s2 + s3);
+      y[i] = (beta == 0.0) ? alpha * dot : alpha * dot + beta * y[i];
+    }
+    return;
+  }
+  // STRIDED ROWS (E.G. A TRANSPOSE VIEW): ACCUMULATE COLUMN BY COLUMN
+  for (unsigned int i = 0; i < M; i++)
+    y[i] = (beta == 0.0) ? 0.0 : beta * y[i];
+  for (unsigned int j = 0; j < N; j++) {
+    const double xj = alpha * x[j];
+    const double* a = matrix_element(A, 0, j);
+    for (unsigned int i = 0; i < M; i++)
+      y[i] += a[(size_t) i * A->rowStride] * xj;
+  }
+}
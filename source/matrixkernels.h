@@ -0,0 +1,31 @@
+//
+//  matrixkernels.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef matrixkernels_h
+#define matrixkernels_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// PRODUCTS WITH AT LEAST THIS MANY MULTIPLY-ADDS ARE SPLIT ACROSS THREADS
+#define MATRIX_THREAD_THRESHOLD (1u << 21)
+
+// GENERAL MATRIX PRODUCT: C = alpha * A * B + beta * C
+// C MUST NOT SHARE STORAGE WITH A OR B. WHEN beta IS ZERO, C IS OVERWRITTEN WITHOUT BEING READ
+void matrix_gemm(const double alpha, const struct Matrix* A, const struct Matrix* B, const double beta, struct Matrix* C);
+
+// GENERAL MATRIX-VECTOR PRODUCT: y = alpha * A * x + beta * y
+void matrix_gemv(const double alpha, const struct Matrix* A, const double* x, const double beta, double* y);
+
+// NUMBER OF THREADS USED FOR LARGE PRODUCTS (DEFAULTS TO THE NUMBER OF ONLINE CPUS)
+void set_matrix_threads(const unsigned int nthreads);
+
+unsigned int get_matrix_threads(void);
+
+#endif /* matrixkernels_h */
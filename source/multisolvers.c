@@ -7,6 +7,7 @@
 //
 
 #include <math.h>
+#include <float.h>
 #include <string.h>
 #include <fenv.h>
 #include <stdio.h>
@@ -15,107 +16,438 @@
 #include <stdlib.h>
 #include "multisolvers.h"
 #include "definitions.h"
+#include "solver.h"
+#include "linearsystems.h"
+#include "jacobian.h"
+#include "matrixkernels.h"
+#include "dual.h"
 
-void linear_iteration_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Linear iteration wasn't able to converge in %i iterations.", max_iter);
-    if (verbose) {
-      printf("Last value : ");
-      print_vector(x0, dimension, precision);
+struct MultivariateContext {
+  multivariate_function f;
+  double* x0;
+  double* tmp1;
+  double* tmp2;
+  unsigned int dimension;
+  double precision;
+};
+
+static void run_multivariate(const char* name, const solver_step step, struct MultivariateContext* context, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  const struct Solver solver = { name, step, context, context->x0, context->dimension };
+  run_solver(&solver, state, max_iter, precision, verbose);
+}
+
+static bool linear_iteration_multi_step(void* ptr, struct SolverState* state) {
+  struct MultivariateContext* c = ptr;
+  solver_evaluate_multi(c->f, c->x0, c->tmp1, state);
+  state->residual = difference_norm(c->x0, c->tmp1, c->dimension);
+  memmove(c->x0, c->tmp1, c->dimension * sizeof(double));
+  return true;
+}
+
+void linear_iteration_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct MultivariateContext context = { f, x0, tmp, NULL, dimension, precision };
+  run_multivariate("Linear iteration", linear_iteration_multi_step, &context, max_iter, precision, verbose, state);
+}
+
+static bool aitkens_delta_multi_step(void* ptr, struct SolverState* state) {
+  struct MultivariateContext* c = ptr;
+  const unsigned int dimension = c->dimension;
+  double* x0 = c->x0;
+  double* tmp1 = c->tmp1;
+  double* tmp2 = c->tmp2;
+  solver_evaluate_multi(c->f, x0, tmp1, state);
+  // THE INTERMEDIATE NORMS ONLY DECIDE CONVERGENCE AND ARE OVERWRITTEN OTHERWISE, SO THEY MAY STOP EARLY
+  state->residual = difference_norm_bounded(x0, tmp1, dimension, c->precision);
+  if (state->residual < c->precision) {
+    memmove(x0, tmp1, dimension * sizeof(double));
+    return true;
+  }
+  solver_evaluate_multi(c->f, tmp1, tmp2, state);
+  state->residual = difference_norm_bounded(tmp1, tmp2, dimension, c->precision);
+  if (state->residual < c->precision) {
+    memmove(x0, tmp2, dimension * sizeof(double));
+    return true;
+  }
+  for (unsigned int i = 0; i < dimension; i++)
+    x0[i] = (x0[i] * tmp2[i] - tmp1[i] * tmp1[i]) / (x0[i] + tmp2[i] - 2 * tmp1[i]);
+  state->residual = difference_norm(tmp2, x0, dimension);
+  return true;
+}
+
+void aitkens_delta_multi(const multivariate_function f, double* x0, double* tmp1, double* tmp2, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct MultivariateContext context = { f, x0, tmp1, tmp2, dimension, precision };
+  run_multivariate("Aitken's Δ squared process", aitkens_delta_multi_step, &context, max_iter, precision, verbose, state);
+}
+
+// ANDERSON MIXING. WITH r_k = f(x_k) - x_k AND THE LAST depth DIFFERENCES ΔR OF r AND ΔG OF
+// f(x), EACH STEP SOLVES min ||r_k - ΔR γ|| AND MOVES TO x_(k+1) = f(x_k) - ΔG γ. ΔR IS KEPT
+// AS Q R, UPDATED BY ONE GRAM-SCHMIDT COLUMN PER STEP AND GIVENS ROTATIONS WHEN THE OLDEST
+// COLUMN LEAVES, SO THE LEAST-SQUARES PROBLEM COSTS O(dimension * depth)
+struct AndersonContext {
+  multivariate_function f;
+  double* x0;
+  double* g;
+  double* r;
+  double* rPrevious;
+  double* gPrevious;
+  double* Q;
+  double* R;
+  double* dG;
+  double* gamma;
+  unsigned int dimension;
+  unsigned int depth;
+  unsigned int count;
+  bool started;
+};
+
+// DROPS THE OLDEST COLUMN OF Q R (AND OF ΔG): THE REMAINING R IS UPPER HESSENBERG AND
+// ROTATIONS OF NEIGHBOURING ROWS (AND THE MATCHING COLUMNS OF Q) MAKE IT TRIANGULAR AGAIN
+static void anderson_delete_oldest(struct AndersonContext* c) {
+  const unsigned int n = c->dimension, m = c->depth, k = c->count;
+  double* R = c->R;
+  for (unsigned int j = 0; j + 1 < k; j++) {
+    const double a = R[j * m + j + 1], b = R[(j + 1) * m + j + 1];
+    const double h = hypot(a, b);
+    const double cs = a / h, sn = b / h;
+    for (unsigned int l = j + 1; l < k; l++) {
+      const double u = R[j * m + l], v = R[(j + 1) * m + l];
+      R[j * m + l] = cs * u + sn * v;
+      R[(j + 1) * m + l] = cs * v - sn * u;
     }
-  } else {
-    f(x0, tmp);
-    if (difference_norm(x0, tmp, dimension) < precision) {
-      if (verbose) {
-        printf("Linear iteration converged to ");
-        print_vector(tmp, dimension, precision);
-      }
-      memmove(x0, tmp, dimension * sizeof(double));
-    } else {
-      if (verbose) {
-        printf("Iteration #%i\t : ", count);
-        print_vector(tmp, dimension, precision);
-      }
-      memmove(x0, tmp, dimension * sizeof(double));
-      count++;
-      linear_iteration_multi(f, x0, tmp, dimension, max_iter, precision, verbose);
+    double* qj = c->Q + (size_t) j * n;
+    double* qk = c->Q + (size_t) (j + 1) * n;
+    for (unsigned int i = 0; i < n; i++) {
+      const double u = qj[i], v = qk[i];
+      qj[i] = cs * u + sn * v;
+      qk[i] = cs * v - sn * u;
     }
   }
+  // SHIFT R LEFT BY ONE COLUMN AND ΔG BY ONE VECTOR
+  for (unsigned int i = 0; i + 1 < k; i++) {
+    for (unsigned int l = i; l + 1 < k; l++)
+      R[i * m + l] = R[i * m + l + 1];
+  }
+  memmove(c->dG, c->dG + n, (size_t) (k - 1) * n * sizeof(double));
+  c->count--;
 }
 
-void aitkens_delta_multi(const multivariate_function f, double* x0, double* tmp1, double* tmp2, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
+// APPENDS dr = r - rPrevious (AND dg) TO THE HISTORY. RETURNS false WHEN dr IS NEARLY IN THE
+// SPAN OF THE HISTORY OR R BECOMES ILL-CONDITIONED, IN WHICH CASE THE CALLER RESTARTS
+static bool anderson_append(struct AndersonContext* c) {
+  const unsigned int n = c->dimension, m = c->depth;
+  if (c->count == m)
+    anderson_delete_oldest(c);
+  const unsigned int k = c->count;
+  double* q = c->Q + (size_t) k * n;
+  double* dg = c->dG + (size_t) k * n;
+  for (unsigned int i = 0; i < n; i++) {
+    q[i] = c->r[i] - c->rPrevious[i];
+    dg[i] = c->g[i] - c->gPrevious[i];
   }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
+  const double original = sqrt(inner_product(q, q, n));
+  // MODIFIED GRAM-SCHMIDT AGAINST THE COLUMNS ALREADY IN Q
+  for (unsigned int j = 0; j < k; j++) {
+    const double* qj = c->Q + (size_t) j * n;
+    const double rjk = inner_product(qj, q, n);
+    c->R[j * m + k] = rjk;
+    for (unsigned int i = 0; i < n; i++)
+      q[i] -= rjk * qj[i];
   }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
+  const double norm = sqrt(inner_product(q, q, n));
+  if (!(norm > ANDERSON_DEPENDENCE * original))
+    return false;
+  for (unsigned int i = 0; i < n; i++)
+    q[i] /= norm;
+  c->R[k * m + k] = norm;
+  c->count++;
+  // CONDITION ESTIMATE FROM THE DIAGONAL OF R
+  double largest = 0, smallest = INFINITY;
+  for (unsigned int j = 0; j < c->count; j++) {
+    largest = fmax(largest, fabs(c->R[j * m + j]));
+    smallest = fmin(smallest, fabs(c->R[j * m + j]));
   }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Aitken's Δ squared process wasn't able to converge in %i iterations.", max_iter);
-    if (verbose) {
-      printf("Last value : ");
-      print_vector(x0, dimension, precision);
+  return largest <= ANDERSON_MAX_CONDITION * smallest;
+}
+
+static bool anderson_multi_step(void* ptr, struct SolverState* state) {
+  struct AndersonContext* c = ptr;
+  const unsigned int n = c->dimension, m = c->depth;
+  solver_evaluate_multi(c->f, c->x0, c->g, state);
+  for (unsigned int i = 0; i < n; i++)
+    c->r[i] = c->g[i] - c->x0[i];
+  state->residual = sqrt(inner_product(c->r, c->r, n));
+  if (m && c->started && !anderson_append(c))
+    c->count = 0;
+  c->started = true;
+  memcpy(c->rPrevious, c->r, n * sizeof(double));
+  memcpy(c->gPrevious, c->g, n * sizeof(double));
+  memcpy(c->x0, c->g, n * sizeof(double));
+  const unsigned int k = c->count;
+  if (!k)
+    return true;
+  // γ = R^-1 Q^T r, THEN x = f(x) - ΔG γ
+  for (unsigned int j = 0; j < k; j++)
+    c->gamma[j] = inner_product(c->Q + (size_t) j * n, c->r, n);
+  for (unsigned int j = k; j-- > 0;) {
+    for (unsigned int l = j + 1; l < k; l++)
+      c->gamma[j] -= c->R[j * m + l] * c->gamma[l];
+    c->gamma[j] /= c->R[j * m + j];
+  }
+  for (unsigned int j = 0; j < k; j++) {
+    const double* dg = c->dG + (size_t) j * n;
+    for (unsigned int i = 0; i < n; i++)
+      c->x0[i] -= c->gamma[j] * dg[i];
+  }
+  return true;
+}
+
+void anderson_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int depth, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  const size_t n = dimension, m = depth;
+  double* work = malloc(((3 + 2 * m) * n + m * m + m + 1) * sizeof(double));
+  struct AndersonContext context = { f, x0, tmp, work, work + n, work + 2 * n, work + 3 * n, work + (3 + m) * n, work + (3 + m) * n + m * m, work + (3 + 2 * m) * n + m * m, dimension, depth, 0, false };
+  const struct Solver solver = { "Anderson acceleration", anderson_multi_step, &context, x0, dimension };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  free(work);
+}
+
+struct NewtonContext {
+  multivariate_function f;
+  matrix_function J;
+  dual_multivariate_function df;
+  struct DualBlock* dualWork;
+  double* x0;
+  double* tmp;
+  unsigned int dimension;
+  struct JacobianEstimator* estimator;
+  struct Matrix* jacobian;
+  unsigned int* pivots;
+  unsigned int reuse;
+  unsigned int sinceFactor;
+  double lastNorm;
+  bool factored;
+};
+
+static bool newton_multi_step(void* ptr, struct SolverState* state) {
+  struct NewtonContext* c = ptr;
+  const unsigned int dimension = c->dimension;
+  // WITH DUAL NUMBERS F AND J COME OUT OF THE SAME SWEEPS, SO J IS ALWAYS FRESH
+  if (c->df)
+    state->evaluations += dual_jacobian(c->df, c->x0, c->tmp, c->jacobian, dimension, c->dualWork);
+  else
+    solver_evaluate_multi(c->f, c->x0, c->tmp, state);
+  const double norm = sqrt(inner_product(c->tmp, c->tmp, dimension));
+  state->value = norm;
+  if (c->df || !c->factored || (c->reuse && c->sinceFactor >= c->reuse) || norm > NEWTON_CHORD_CONTRACTION * c->lastNorm) {
+    if (c->J)
+      c->J(c->x0, c->jacobian);
+    else if (!c->df)
+      state->evaluations += estimate_jacobian(c->estimator, c->x0, c->tmp, c->jacobian);
+    c->factored = lu_factor(c->jacobian, c->pivots);
+    c->sinceFactor = 0;
+    if (!c->factored) {
+      fprintf(stderr, "ERROR: Singular Jacobian matrix\n");
+      state->termination = SOLVER_SINGULAR_JACOBIAN;
+      return false;
     }
+  }
+  c->lastNorm = norm;
+  c->sinceFactor++;
+  lu_solve(c->jacobian, c->pivots, c->tmp);
+  for (unsigned int i = 0; i < dimension; i++)
+    c->x0[i] -= c->tmp[i];
+  state->residual = sqrt(inner_product(c->tmp, c->tmp, dimension));
+  return true;
+}
+
+void newton_chord_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int reuse, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  struct NewtonContext context = { f, J, NULL, NULL, x0, tmp, dimension, J ? NULL : new_jacobian_estimator(f, dimension, NULL, 1), new_matrix(dimension, dimension), malloc(dimension * sizeof(unsigned int) + 1), reuse, 0, INFINITY, false };
+  const struct Solver solver = { reuse == 1 ? "Newton's method" : "Chord Newton's method", newton_multi_step, &context, x0, dimension };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  destroy_jacobian_estimator(context.estimator);
+  destroy_matrix(context.jacobian);
+  free(context.pivots);
+}
+
+void newton_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  newton_chord_multi(f, J, x0, tmp, dimension, 1, max_iter, precision, verbose, state);
+}
+
+void newton_dual_multi(const dual_multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  struct NewtonContext context = { NULL, NULL, f, malloc(2 * (size_t) dimension * sizeof(struct DualBlock)), x0, tmp, dimension, NULL, new_matrix(dimension, dimension), malloc(dimension * sizeof(unsigned int) + 1), 1, 0, INFINITY, false };
+  const struct Solver solver = { "Newton's method (dual numbers)", newton_multi_step, &context, x0, dimension };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  free(context.dualWork);
+  destroy_matrix(context.jacobian);
+  free(context.pivots);
+}
+
+struct BroydenContext {
+  multivariate_function f;
+  double* x0;
+  double* F;
+  double* Fnew;
+  double* s;
+  double* Hy;
+  double* v;
+  unsigned int dimension;
+  struct Matrix* H;
+  double scale;
+  double* U;
+  double* V;
+  unsigned int memory;
+  unsigned int count;
+};
+
+// out = H w
+static void broyden_apply(const struct BroydenContext* c, const double* w, double* out) {
+  const unsigned int n = c->dimension;
+  if (c->H) {
+    matrix_gemv(1.0, c->H, w, 0.0, out);
+    return;
+  }
+  for (unsigned int i = 0; i < n; i++)
+    out[i] = c->scale * w[i];
+  for (unsigned int k = 0; k < c->count; k++) {
+    const double* u = c->U + (size_t) k * n;
+    const double vw = inner_product(c->V + (size_t) k * n, w, n);
+    for (unsigned int i = 0; i < n; i++)
+      out[i] += u[i] * vw;
+  }
+}
+
+// out = H^T w
+static void broyden_apply_transpose(const struct BroydenContext* c, const double* w, double* out) {
+  const unsigned int n = c->dimension;
+  if (c->H) {
+    const struct Matrix Ht = matrix_transpose(c->H);
+    matrix_gemv(1.0, &Ht, w, 0.0, out);
+    return;
+  }
+  for (unsigned int i = 0; i < n; i++)
+    out[i] = c->scale * w[i];
+  for (unsigned int k = 0; k < c->count; k++) {
+    const double* v = c->V + (size_t) k * n;
+    const double uw = inner_product(c->U + (size_t) k * n, w, n);
+    for (unsigned int i = 0; i < n; i++)
+      out[i] += v[i] * uw;
+  }
+}
+
+static bool pseudo_newton_step(void* ptr, struct SolverState* state) {
+  struct BroydenContext* c = ptr;
+  const unsigned int n = c->dimension;
+  double* s = c->s;
+  double* y = c->Fnew;
+  broyden_apply(c, c->F, s);
+  for (unsigned int i = 0; i < n; i++) {
+    s[i] = -s[i];
+    c->x0[i] += s[i];
+  }
+  state->residual = sqrt(inner_product(s, s, n));
+  solver_evaluate_multi(c->f, c->x0, y, state);
+  for (unsigned int i = 0; i < n; i++) {
+    const double fi = y[i];
+    y[i] -= c->F[i];
+    c->F[i] = fi;
+  }
+  if (!c->H && c->count == c->memory)
+    c->count = 0;
+  broyden_apply(c, y, c->Hy);
+  const double denominator = inner_product(s, c->Hy, n);
+  if (denominator == 0 || !isfinite(denominator))
+    return true;
+  // H += (s - H y) (s^T H) / (s^T H y)
+  double* u = c->H ? c->Hy : c->U + (size_t) c->count * n;
+  double* v = c->H ? c->v : c->V + (size_t) c->count * n;
+  broyden_apply_transpose(c, s, v);
+  for (unsigned int i = 0; i < n; i++)
+    u[i] = (s[i] - c->Hy[i]) / denominator;
+  if (!c->H) {
+    c->count++;
+    return true;
+  }
+  for (unsigned int i = 0; i < n; i++) {
+    double* row = matrix_element(c->H, i, 0);
+    const double ui = u[i];
+    for (unsigned int j = 0; j < n; j++)
+      row[j] += ui * v[j];
+  }
+  return true;
+}
+
+void pseudo_newton_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  double* work = malloc(((size_t) 4 * dimension + 1) * sizeof(double));
+  struct BroydenContext context = { f, x0, tmp, work, work + dimension, work + 2 * dimension, work + 3 * dimension, dimension, new_matrix_eye(dimension, dimension), 0, NULL, NULL, 0, 0 };
+  solver_evaluate_multi(f, x0, tmp, state);
+  struct Matrix* jacobian = new_matrix(dimension, dimension);
+  unsigned int* pivots = malloc(dimension * sizeof(unsigned int) + 1);
+  if (J) {
+    J(x0, jacobian);
   } else {
-    f(x0, tmp1);
-    if (difference_norm(x0, tmp1, dimension) < precision) {
-      if (verbose) {
-        printf("Aitken's Δ squared process converged to ");
-        print_vector(tmp1, dimension, precision);
-      }
-      memmove(x0, tmp1, dimension * sizeof(double));
-    } else {
-      if (verbose) {
-        printf("Iteration #%i\t : ", count);
-        print_vector(tmp1, dimension, precision);
-      }
-      count++;
-      f(tmp1, tmp2);
-      if (difference_norm(tmp1, tmp2, dimension) < precision) {
-        if (verbose) {
-          printf("Aitken's Δ squared process converged to ");
-          print_vector(tmp2, dimension, precision);
-        }
-        memmove(x0, tmp2, dimension * sizeof(double));
-      } else {
-        if (verbose) {
-          printf("Iteration #%i\t : ", count);
-          print_vector(tmp2, dimension, precision);
-        }
-        count++;
-        for (unsigned int i = 0; i < dimension; i++)
-          x0[i] = (x0[i] * tmp2[i] - tmp1[i] * tmp1[i]) / (x0[i] + tmp2[i] - 2 * tmp1[i]);
-        if (difference_norm(tmp2, x0, dimension) < precision) {
-          if (verbose) {
-            printf("Aitken's Δ squared process converged to ");
-            print_vector(x0, dimension, precision);
-          }
-        } else {
-          aitkens_delta_multi(f, x0, tmp1, tmp2, dimension, max_iter, precision, verbose);
-        }
-      }
-    }
+    struct JacobianEstimator* estimator = new_jacobian_estimator(f, dimension, NULL, 1);
+    state->evaluations += estimate_jacobian(estimator, x0, tmp, jacobian);
+    destroy_jacobian_estimator(estimator);
+  }
+  const bool regular = lu_factor(jacobian, pivots);
+  if (regular)
+    lu_solve_many(jacobian, pivots, context.H);
+  destroy_matrix(jacobian);
+  free(pivots);
+  if (regular) {
+    const struct Solver solver = { "Pseudo-Newton's method", pseudo_newton_step, &context, x0, dimension };
+    run_solver(&solver, state, max_iter, precision, verbose);
+  } else {
+    fprintf(stderr, "ERROR: Singular Jacobian matrix\n");
+    state->termination = SOLVER_SINGULAR_JACOBIAN;
+  }
+  destroy_matrix(context.H);
+  free(work);
+}
+
+void pseudo_newton_limited_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int memory, const double initial_scale, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  const unsigned int m = memory ? memory : 1;
+  double* work = malloc(((size_t) (3 + 2 * m) * dimension + 1) * sizeof(double));
+  struct BroydenContext context = { f, x0, tmp, work, work + dimension, work + 2 * dimension, NULL, dimension, NULL, initial_scale, work + 3 * dimension, work + (size_t) (3 + m) * dimension, m, 0 };
+  solver_evaluate_multi(f, x0, tmp, state);
+  if (initial_scale == 0) {
+    // SCALE FROM THE DIRECTIONAL DERIVATIVE ALONG d = f(x0): scale = (d . d) / (d . J d)
+    const double norm = sqrt(inner_product(tmp, tmp, dimension));
+    const double h = sqrt(DBL_EPSILON) * fmax(sqrt(inner_product(x0, x0, dimension)), 1.0) / (norm > 0 ? norm : 1.0);
+    double* probe = context.s;
+    double* fprobe = context.Fnew;
+    for (unsigned int i = 0; i < dimension; i++)
+      probe[i] = x0[i] + h * tmp[i];
+    solver_evaluate_multi(f, probe, fprobe, state);
+    double dJd = 0;
+    for (unsigned int i = 0; i < dimension; i++)
+      dJd += tmp[i] * (fprobe[i] - tmp[i]) / h;
+    context.scale = (dJd != 0 && isfinite(dJd)) ? norm * norm / dJd : 1.0;
   }
+  const struct Solver solver = { "Limited-memory pseudo-Newton's method", pseudo_newton_step, &context, x0, dimension };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  free(work);
 }
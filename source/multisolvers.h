@@ -12,17 +12,59 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "definitions.h"
+#include "solver.h"
+#include "dual.h"
 
 // IMPLEMENTATION OF MULTIVARIATE LINEAR ITERATION
 // CONVERGENCE: LINEAR
-void linear_iteration_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose);
+void linear_iteration_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// IMPLEMENTATION OF ANDERSON ACCELERATION OF LINEAR ITERATION (ANDERSON MIXING)
+// COMBINES THE LAST depth ITERATES TO MINIMISE THE LINEARISED RESIDUAL, AT ONE f CALL PER
+// ITERATION LIKE linear_iteration_multi (WHICH IS depth 0). THE HISTORY IS DISCARDED WHEN A
+// NEW DIFFERENCE IS NEARLY DEPENDENT ON IT OR ITS CONDITION ESTIMATE EXCEEDS
+// ANDERSON_MAX_CONDITION. ALL WORKSPACE, O((2 depth + 3) dimension), IS ALLOCATED ONCE
+// CONVERGENCE: LINEAR, TYPICALLY FAR FASTER THAN LINEAR ITERATION
+#define ANDERSON_DEPENDENCE 1e-8
+#define ANDERSON_MAX_CONDITION 1e10
+
+void anderson_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int depth, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATION OF MULTIVARIATE AITKEN'S Δ SQUARED PROCESS
 // CONVERGENCE: LINEAR
-void aitkens_delta_multi(const multivariate_function f, double* x0, double* tmp1, double* tmp2, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose);
+void aitkens_delta_multi(const multivariate_function f, double* x0, double* tmp1, double* tmp2, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATION OF MULTIVARIATE NEWTON'S METHOD
+// SOLVES J(x) dx = f(x) BY LU FACTORISATION WITH PARTIAL PIVOTING ON EVERY ITERATION
+// tmp HOLDS f(x) AND THEN THE STEP dx. J MAY BE NULL, IN WHICH CASE THE JACOBIAN IS
+// ESTIMATED BY FORWARD DIFFERENCES (dimension EXTRA f CALLS PER FACTORISATION)
+// CONVERGENCE: QUADRATIC
+void newton_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// NEWTON'S METHOD WITH F WRITTEN AGAINST struct DualBlock: EACH ITERATION GETS F(x) AND THE
+// EXACT JACOBIAN FROM ceil(dimension / DUAL_LANES) CALLS OF f (SEE dual_jacobian)
 // CONVERGENCE: QUADRATIC
-void newton_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose);
+void newton_dual_multi(const dual_multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// IMPLEMENTATION OF THE CHORD / SHAMANSKII VARIANT OF NEWTON'S METHOD
+// REUSES A FACTORISED JACOBIAN FOR UP TO reuse ITERATIONS (0 MEANS NO LIMIT), AND
+// REFACTORS EARLIER WHENEVER |f(x)| SHRINKS BY LESS THAN NEWTON_CHORD_CONTRACTION
+// CONVERGENCE: LINEAR (CHORD) TO SUPERLINEAR (SHAMANSKII)
+#define NEWTON_CHORD_CONTRACTION 0.5
+
+void newton_chord_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int reuse, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// IMPLEMENTATION OF THE ACCELERATED PSEUDO-NEWTON'S METHOD (CONTE ALGORITHM 2.17, BROYDEN)
+// KEEPS AN APPROXIMATE INVERSE JACOBIAN H AND CORRECTS IT WITH A RANK-ONE SHERMAN-MORRISON
+// UPDATE, SO EACH ITERATION COSTS ONE f CALL AND O(dimension^2) WORK. H STARTS AS THE
+// INVERSE OF J(x0), OR OF A FINITE-DIFFERENCE ESTIMATE WHEN J IS NULL
+// CONVERGENCE: SUPERLINEAR
+void pseudo_newton_multi(const multivariate_function f, const matrix_function J, double* x0, double* tmp, const unsigned int dimension, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// LIMITED-MEMORY VARIANT: H = initial_scale * I PLUS THE LAST memory RANK-ONE UPDATES, SO
+// STORAGE IS O(memory * dimension). THE HISTORY RESTARTS FROM initial_scale * I ONCE FULL.
+// initial_scale == 0 ESTIMATES THE SCALE FROM ONE EXTRA f CALL ALONG f(x0)
+// CONVERGENCE: SUPERLINEAR
+void pseudo_newton_limited_multi(const multivariate_function f, double* x0, double* tmp, const unsigned int dimension, const unsigned int memory, const double initial_scale, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 #endif /* multisolvers_h */
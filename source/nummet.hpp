@@ -0,0 +1,693 @@
+//
+//  nummet.hpp
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef nummet_hpp
+#define nummet_hpp
+
+// HEADER-ONLY C++17 FRONT END: THE SAME METHODS AS THE C API, AS TEMPLATES OVER ANY CALLABLE
+// (LAMBDAS, FUNCTORS WITH STATE, FUNCTION POINTERS), SO A CHEAP f IS INLINED INTO THE LOOP
+// INSTEAD OF BEING CALLED THROUGH univariate_function / multivariate_function. THE
+// PRECISION TYPE T (float, double, long double) AND, FOR SYSTEMS, A FIXED DIMENSION N
+// (std::array STORAGE; N = 0 MEANS std::vector SIZED AT RUN TIME) ARE TEMPLATE PARAMETERS.
+// THE C FUNCTIONS ARE UNCHANGED AND REMAIN THE ENTRY POINTS FOR C CALLERS
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "solver.h"
+}
+
+namespace nummet {
+
+// ITERATE, COUNTERS, LAST RESIDUAL AND TERMINATION REASON OF ONE SOLVE (SEE struct SolverState)
+template <typename X, typename T = X>
+struct Result {
+  X x;
+  unsigned int iterations = 0;
+  unsigned long evaluations = 0;
+  T residual = std::numeric_limits<T>::infinity();
+  SolverTermination termination = SOLVER_RUNNING;
+};
+
+// TWO-POINT METHODS SELECTED AT COMPILE TIME BY solve<Method>
+enum class Method {
+  Bisection,
+  Secant,
+  FalsePosition,
+  Illinois,
+  AndersonBjorck,
+  Brent
+};
+
+// DEFAULT TOLERANCE: A FEW HUNDRED ULPS OF THE PRECISION TYPE
+template <typename T>
+constexpr T default_precision() {
+  return 256 * std::numeric_limits<T>::epsilon();
+}
+
+namespace detail {
+
+// LOOP ENGINE SHARED BY EVERY METHOD (THE TEMPLATE COUNTERPART OF run_solver)
+// step RETURNS false, WITH result.termination SET, WHEN IT CANNOT PROCEED
+template <typename X, typename T, typename Step>
+inline void run(Result<X, T>& result, Step&& step, const T precision, const unsigned int max_iter) {
+  result.termination = SOLVER_RUNNING;
+  while (true) {
+    if (max_iter && result.iterations >= max_iter) {
+      result.termination = SOLVER_MAX_ITERATIONS;
+      return;
+    }
+    if (!step()) {
+      if (result.termination == SOLVER_RUNNING)
+        result.termination = SOLVER_INVALID_ARGUMENT;
+      return;
+    }
+    result.iterations++;
+    if (std::isnan(result.residual) || std::isinf(result.residual)) {
+      result.termination = SOLVER_OUT_OF_RANGE;
+      return;
+    }
+    if (result.residual < precision) {
+      result.termination = SOLVER_CONVERGED;
+      return;
+    }
+  }
+}
+
+template <typename T, typename F>
+inline T evaluate(F& f, const T x, unsigned long& evaluations) {
+  evaluations++;
+  return static_cast<T>(f(x));
+}
+
+// PRIMES A BRACKET: false ON AN INVALID ONE, A ZERO RESIDUAL WHEN AN ENDPOINT IS A ROOT
+template <typename T, typename F>
+inline bool prime_bracket(F& f, Result<T>& result, T& x0, T& x1, T& f0, T& f1) {
+  f0 = evaluate(f, x0, result.evaluations);
+  f1 = evaluate(f, x1, result.evaluations);
+  if (f0 == 0 || f1 == 0) {
+    result.x = (f0 == 0) ? x0 : x1;
+    result.residual = 0;
+    return true;
+  }
+  if (!(f0 * f1 < 0)) {
+    result.termination = SOLVER_INVALID_BRACKET;
+    return false;
+  }
+  result.residual = std::fabs(x1 - x0);
+  return true;
+}
+
+} // namespace detail
+
+// BISECTION METHOD
+template <typename T = double, typename F>
+Result<T> bisection(F f, T x0, T x1, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x0};
+  T f0 = 0, f1 = 0;
+  bool primed = false;
+  detail::run(result, [&] {
+    if (!primed) {
+      primed = true;
+      if (!detail::prime_bracket(f, result, x0, x1, f0, f1) || result.residual == 0)
+        return result.termination == SOLVER_RUNNING;
+    }
+    const T x2 = (x0 + x1) / 2;
+    const T f2 = detail::evaluate(f, x2, result.evaluations);
+    result.x = x2;
+    result.residual = (f2 == 0) ? T(0) : std::fmin(std::fabs(x0 - x2), std::fabs(x1 - x2));
+    if (f2 * f0 < 0) {
+      x1 = x0;
+      f1 = f0;
+    }
+    x0 = x2;
+    f0 = f2;
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// LINEAR (FIXED-POINT) ITERATION x = g(x)
+template <typename T = double, typename G>
+Result<T> linear_iteration(G g, const T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x0};
+  detail::run(result, [&] {
+    const T x1 = detail::evaluate(g, result.x, result.evaluations);
+    result.residual = std::fabs(result.x - x1);
+    result.x = x1;
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// AITKEN'S Δ SQUARED PROCESS ON x = g(x)
+template <typename T = double, typename G>
+Result<T> aitkens_delta(G g, const T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x0};
+  detail::run(result, [&] {
+    const T y0 = result.x;
+    const T y1 = detail::evaluate(g, y0, result.evaluations);
+    if (std::fabs(y0 - y1) < precision) {
+      result.x = y1;
+      result.residual = std::fabs(y0 - y1);
+      return true;
+    }
+    const T y2 = detail::evaluate(g, y1, result.evaluations);
+    if (std::fabs(y1 - y2) < precision) {
+      result.x = y2;
+      result.residual = std::fabs(y1 - y2);
+      return true;
+    }
+    const T corrected = (y0 * y2 - y1 * y1) / (y0 + y2 - 2 * y1);
+    result.residual = std::fabs(y2 - corrected);
+    result.x = corrected;
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// NEWTON'S METHOD WITH DERIVATIVE fp
+template <typename T = double, typename F, typename FP>
+Result<T> newton(F f, FP fp, const T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x0};
+  detail::run(result, [&] {
+    const T x = result.x;
+    result.x = x - detail::evaluate(f, x, result.evaluations) / static_cast<T>(fp(x));
+    result.residual = std::fabs(x - result.x);
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// SECANT METHOD (ARGUMENT ORDER AS IN THE C API: x1 FIRST)
+template <typename T = double, typename F>
+Result<T> secant(F f, T x1, T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x1};
+  T f0 = detail::evaluate(f, x0, result.evaluations);
+  T f1 = detail::evaluate(f, x1, result.evaluations);
+  detail::run(result, [&] {
+    const T x2 = (x0 * f1 - x1 * f0) / (f1 - f0);
+    result.residual = std::fabs(x2 - x1);
+    x0 = x1;
+    f0 = f1;
+    x1 = x2;
+    f1 = detail::evaluate(f, x2, result.evaluations);
+    result.x = x2;
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+namespace detail {
+
+// FALSE POSITION AND ITS ILLINOIS / ANDERSON-BJÖRCK MODIFICATIONS
+template <Method M, typename T, typename F>
+Result<T> false_position(F& f, T x1, T x0, const T precision, const unsigned int max_iter) {
+  Result<T> result{x1};
+  T f0 = 0, f1 = 0;
+  bool primed = false;
+  detail::run(result, [&] {
+    if (!primed) {
+      primed = true;
+      if constexpr (M == Method::FalsePosition) {
+        f0 = evaluate(f, x0, result.evaluations);
+        f1 = evaluate(f, x1, result.evaluations);
+      } else if (!prime_bracket(f, result, x0, x1, f0, f1) || result.residual == 0) {
+        return result.termination == SOLVER_RUNNING;
+      }
+    }
+    const T x2 = (x0 * f1 - x1 * f0) / (f1 - f0);
+    const T f2 = evaluate(f, x2, result.evaluations);
+    result.x = x2;
+    result.residual = std::fmin(std::fabs(x2 - x1), std::fabs(x2 - x0));
+    if constexpr (M == Method::FalsePosition) {
+      if (f2 * f0 < 0) {
+        x1 = x2;
+        f1 = f2;
+      } else {
+        x0 = x2;
+        f0 = f2;
+      }
+    } else {
+      if (f2 == 0)
+        result.residual = 0;
+      if (f2 * f1 < 0) {
+        x0 = x1;
+        f0 = f1;
+      } else {
+        const T m = (M == Method::AndersonBjorck) ? 1 - f2 / f1 : T(0.5);
+        f0 *= (m > 0) ? m : T(0.5);
+      }
+      x1 = x2;
+      f1 = f2;
+    }
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+} // namespace detail
+
+template <typename T = double, typename F>
+Result<T> false_position(F f, const T x1, const T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  return detail::false_position<Method::FalsePosition>(f, x1, x0, precision, max_iter);
+}
+
+template <typename T = double, typename F>
+Result<T> illinois(F f, const T x1, const T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  return detail::false_position<Method::Illinois>(f, x1, x0, precision, max_iter);
+}
+
+template <typename T = double, typename F>
+Result<T> anderson_bjorck(F f, const T x1, const T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  return detail::false_position<Method::AndersonBjorck>(f, x1, x0, precision, max_iter);
+}
+
+// BRENT'S METHOD: b IS THE BEST ESTIMATE, c THE CONTRAPOINT AND a THE PREVIOUS ESTIMATE
+template <typename T = double, typename F>
+Result<T> brent(F f, T x0, T x1, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x1};
+  T a = x0, b = x1, c = x1, fa = 0, fb = 0, fc = 0, step = 0, lastStep = 0;
+  bool primed = false;
+  detail::run(result, [&] {
+    if (!primed) {
+      primed = true;
+      if (!detail::prime_bracket(f, result, a, b, fa, fb) || result.residual == 0)
+        return result.termination == SOLVER_RUNNING;
+      c = b;
+      fc = fb;
+    }
+    if ((fb > 0) == (fc > 0)) {
+      c = a;
+      fc = fa;
+      step = lastStep = b - a;
+    }
+    if (std::fabs(fc) < std::fabs(fb)) {
+      a = b;
+      b = c;
+      c = a;
+      fa = fb;
+      fb = fc;
+      fc = fa;
+    }
+    const T tolerance = 2 * std::numeric_limits<T>::epsilon() * std::fabs(b) + precision / 2;
+    const T middle = (c - b) / 2;
+    result.x = b;
+    if (std::fabs(middle) <= tolerance || fb == 0) {
+      result.residual = 0;
+      return true;
+    }
+    if (std::fabs(lastStep) >= tolerance && std::fabs(fa) > std::fabs(fb)) {
+      const T s = fb / fa;
+      T p, q;
+      if (a == c) {
+        p = 2 * middle * s;
+        q = 1 - s;
+      } else {
+        const T r0 = fa / fc, r1 = fb / fc;
+        p = s * (2 * middle * r0 * (r0 - r1) - (b - a) * (r1 - 1));
+        q = (r0 - 1) * (r1 - 1) * (s - 1);
+      }
+      if (p > 0)
+        q = -q;
+      p = std::fabs(p);
+      if (2 * p < std::fmin(3 * middle * q - std::fabs(tolerance * q), std::fabs(lastStep * q))) {
+        lastStep = step;
+        step = p / q;
+      } else {
+        step = lastStep = middle;
+      }
+    } else {
+      step = lastStep = middle;
+    }
+    a = b;
+    fa = fb;
+    b += (std::fabs(step) > tolerance) ? step : std::copysign(tolerance, middle);
+    fb = detail::evaluate(f, b, result.evaluations);
+    result.x = b;
+    result.residual = 2 * std::fabs(middle);
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// MÜLLER'S PROCESS (ARGUMENT ORDER AS IN THE C API: x2 FIRST)
+template <typename T = double, typename F>
+Result<T> muller(F f, T x2, T x1, T x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Result<T> result{x2};
+  T f0 = detail::evaluate(f, x0, result.evaluations);
+  T f1 = detail::evaluate(f, x1, result.evaluations);
+  T f2 = detail::evaluate(f, x2, result.evaluations);
+  detail::run(result, [&] {
+    const T lambda0 = (x2 - x1) / (x1 - x0);
+    const T delta = 1 + lambda0;
+    const T g = f0 * lambda0 * lambda0 - f1 * delta * delta + f2 * (lambda0 + delta);
+    const T discriminant = g * g - 4 * f2 * delta * lambda0 * (f0 * lambda0 - f1 * delta + f2);
+    if (discriminant < 0) {
+      result.termination = SOLVER_INVALID_ARGUMENT;
+      return false;
+    }
+    const T root = std::sqrt(discriminant);
+    const T lambda1 = (-2 * f2 * delta) / ((g > 0) ? g + root : g - root);
+    const T x3 = x2 + lambda1 * (x2 - x1);
+    result.residual = std::fabs(x2 - x3);
+    x0 = x1;
+    x1 = x2;
+    x2 = x3;
+    f0 = f1;
+    f1 = f2;
+    f2 = detail::evaluate(f, x3, result.evaluations);
+    result.x = x3;
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// TWO-POINT METHOD CHOSEN AT COMPILE TIME, ALWAYS CALLED WITH THE INTERVAL [a, b]
+template <Method M, typename T = double, typename F>
+Result<T> solve(F f, const T a, const T b, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  if constexpr (M == Method::Bisection)
+    return bisection(f, a, b, precision, max_iter);
+  else if constexpr (M == Method::Secant)
+    return secant(f, b, a, precision, max_iter);
+  else if constexpr (M == Method::FalsePosition)
+    return false_position(f, b, a, precision, max_iter);
+  else if constexpr (M == Method::Illinois)
+    return illinois(f, b, a, precision, max_iter);
+  else if constexpr (M == Method::AndersonBjorck)
+    return anderson_bjorck(f, b, a, precision, max_iter);
+  else
+    return brent(f, a, b, precision, max_iter);
+}
+
+// NONLINEAR SYSTEMS
+
+namespace detail {
+
+// EVERY VECTOR AND MATRIX IS ALLOCATED HERE. A FIXED DIMENSION N ONLY HOLDS N ENTRIES, SO A
+// RUN-TIME SIZE n != N (E.G. TOO MANY INTERPOLATION NODES) IS REJECTED LIKE THE C API
+// REJECTS INVALID ARGUMENTS, RATHER THAN WRITING PAST THE std::array
+template <typename T, std::size_t N>
+struct Storage {
+  using vector = std::array<T, N>;
+  using matrix = std::array<T, N * N>;
+  static void check_size(const std::size_t n) {
+    if (n != N) {
+      std::fprintf(stderr, "ERROR: Size %zu does not match the fixed dimension %zu\n", n, N);
+      std::exit(1);
+    }
+  }
+  static vector make_vector(const std::size_t n) {
+    check_size(n);
+    return vector{};
+  }
+  static matrix make_matrix(const std::size_t n) {
+    check_size(n);
+    return matrix{};
+  }
+};
+
+template <typename T>
+struct Storage<T, 0> {
+  using vector = std::vector<T>;
+  using matrix = std::vector<T>;
+  static vector make_vector(const std::size_t n) { return vector(n); }
+  static matrix make_matrix(const std::size_t n) { return matrix(n * n); }
+};
+
+template <typename V>
+inline auto norm(const V& v, const std::size_t n) {
+  typename V::value_type sum = 0;
+  for (std::size_t i = 0; i < n; i++)
+    sum += v[i] * v[i];
+  return std::sqrt(sum);
+}
+
+// SOLVES A x = b IN PLACE (ROW-MAJOR A, OVERWRITTEN) BY GAUSSIAN ELIMINATION WITH PARTIAL
+// PIVOTING. RETURNS false IF A IS SINGULAR
+template <typename M, typename V>
+inline bool solve_linear(M& A, V& b, const std::size_t n) {
+  using T = typename V::value_type;
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t pivot = k;
+    for (std::size_t i = k + 1; i < n; i++) {
+      if (std::fabs(A[i * n + k]) > std::fabs(A[pivot * n + k]))
+        pivot = i;
+    }
+    if (A[pivot * n + k] == 0)
+      return false;
+    if (pivot != k) {
+      for (std::size_t j = k; j < n; j++)
+        std::swap(A[k * n + j], A[pivot * n + j]);
+      std::swap(b[k], b[pivot]);
+    }
+    const T inverse = 1 / A[k * n + k];
+    for (std::size_t i = k + 1; i < n; i++) {
+      const T factor = A[i * n + k] * inverse;
+      for (std::size_t j = k + 1; j < n; j++)
+        A[i * n + j] -= factor * A[k * n + j];
+      b[i] -= factor * b[k];
+    }
+  }
+  for (std::size_t k = n; k-- > 0;) {
+    T sum = b[k];
+    for (std::size_t j = k + 1; j < n; j++)
+      sum -= A[k * n + j] * b[j];
+    b[k] = sum / A[k * n + k];
+  }
+  return true;
+}
+
+// FORWARD-DIFFERENCE JACOBIAN (ROW-MAJOR) REUSING fx = F(x)
+template <typename F, typename V, typename M>
+inline void estimate_jacobian(F& f, V& x, const V& fx, V& work, M& J, const std::size_t n, unsigned long& evaluations) {
+  using T = typename V::value_type;
+  for (std::size_t j = 0; j < n; j++) {
+    const T xj = x[j];
+    const T h = std::sqrt(std::numeric_limits<T>::epsilon()) * std::fmax(std::fabs(xj), T(1));
+    x[j] = xj + h;
+    f(x, work);
+    evaluations++;
+    x[j] = xj;
+    for (std::size_t i = 0; i < n; i++)
+      J[i * n + j] = (work[i] - fx[i]) / h;
+  }
+}
+
+} // namespace detail
+
+// STORAGE FOR AN N-DIMENSIONAL SYSTEM: std::array FOR N > 0, std::vector FOR N = 0. THE
+// SYSTEM SOLVERS TAKE THEIR DIMENSION FROM x0.size(), WHICH FOR N > 0 IS N BY TYPE; THEIR
+// WORK VECTORS GO THROUGH THE SAME SIZE CHECK AS EVERYTHING ELSE
+template <typename T, std::size_t N = 0>
+using Vector = typename detail::Storage<T, N>::vector;
+
+template <typename T, std::size_t N = 0>
+using SquareMatrix = typename detail::Storage<T, N>::matrix;
+
+// LINEAR ITERATION x = G(x); g(x, gx) WRITES G(x) TO gx
+template <std::size_t N = 0, typename T = double, typename G>
+Result<Vector<T, N>, T> linear_iteration_system(G g, const Vector<T, N>& x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  const std::size_t n = x0.size();
+  Result<Vector<T, N>, T> result{x0};
+  Vector<T, N> next = detail::Storage<T, N>::make_vector(n);
+  detail::run(result, [&] {
+    g(result.x, next);
+    result.evaluations++;
+    T sum = 0;
+    for (std::size_t i = 0; i < n; i++)
+      sum += (next[i] - result.x[i]) * (next[i] - result.x[i]);
+    result.residual = std::sqrt(sum);
+    std::swap(result.x, next);
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+namespace detail {
+
+// jacobian(x, fx, J) RECEIVES F(x) SO FINITE DIFFERENCES CAN REUSE IT
+template <std::size_t N, typename T, typename F, typename J>
+Result<Vector<T, N>, T> newton_system(F& f, J&& jacobian, const Vector<T, N>& x0, const T precision, const unsigned int max_iter) {
+  const std::size_t n = x0.size();
+  Result<Vector<T, N>, T> result{x0};
+  Vector<T, N> fx = Storage<T, N>::make_vector(n);
+  SquareMatrix<T, N> A = Storage<T, N>::make_matrix(n);
+  run(result, [&] {
+    f(result.x, fx);
+    result.evaluations++;
+    jacobian(result.x, fx, A, result.evaluations);
+    if (!solve_linear(A, fx, n)) {
+      result.termination = SOLVER_SINGULAR_JACOBIAN;
+      return false;
+    }
+    for (std::size_t i = 0; i < n; i++)
+      result.x[i] -= fx[i];
+    result.residual = norm(fx, n);
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+} // namespace detail
+
+// NEWTON'S METHOD: f(x, fx) WRITES F(x); jacobian(x, J) WRITES THE ROW-MAJOR JACOBIAN
+template <std::size_t N = 0, typename T = double, typename F, typename J>
+Result<Vector<T, N>, T> newton_system(F f, J jacobian, const Vector<T, N>& x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  return detail::newton_system<N, T>(f, [&](const Vector<T, N>& x, const Vector<T, N>&, SquareMatrix<T, N>& A, unsigned long&) {
+    jacobian(x, A);
+  }, x0, precision, max_iter);
+}
+
+// NEWTON'S METHOD WITH A FORWARD-DIFFERENCE JACOBIAN
+template <std::size_t N = 0, typename T = double, typename F>
+Result<Vector<T, N>, T> newton_system(F f, const Vector<T, N>& x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  Vector<T, N> probe = x0;
+  Vector<T, N> work = detail::Storage<T, N>::make_vector(x0.size());
+  return detail::newton_system<N, T>(f, [&](const Vector<T, N>& x, const Vector<T, N>& fx, SquareMatrix<T, N>& A, unsigned long& evaluations) {
+    probe = x;
+    detail::estimate_jacobian(f, probe, fx, work, A, x.size(), evaluations);
+  }, x0, precision, max_iter);
+}
+
+// BROYDEN'S (PSEUDO-NEWTON) METHOD: THE JACOBIAN IS ESTIMATED ONCE BY FORWARD DIFFERENCES AND
+// THEN KEPT UP TO DATE WITH RANK-ONE UPDATES B += (y - B s) s^T / (s^T s)
+template <std::size_t N = 0, typename T = double, typename F>
+Result<Vector<T, N>, T> broyden_system(F f, const Vector<T, N>& x0, const T precision = default_precision<T>(), const unsigned int max_iter = 1000) {
+  const std::size_t n = x0.size();
+  Result<Vector<T, N>, T> result{x0};
+  Vector<T, N> fx = detail::Storage<T, N>::make_vector(n);
+  Vector<T, N> fnew = detail::Storage<T, N>::make_vector(n);
+  Vector<T, N> s = detail::Storage<T, N>::make_vector(n);
+  SquareMatrix<T, N> B = detail::Storage<T, N>::make_matrix(n);
+  SquareMatrix<T, N> A = detail::Storage<T, N>::make_matrix(n);
+  f(result.x, fx);
+  result.evaluations++;
+  detail::estimate_jacobian(f, result.x, fx, fnew, B, n, result.evaluations);
+  detail::run(result, [&] {
+    A = B;
+    for (std::size_t i = 0; i < n; i++)
+      s[i] = -fx[i];
+    if (!detail::solve_linear(A, s, n)) {
+      result.termination = SOLVER_SINGULAR_JACOBIAN;
+      return false;
+    }
+    for (std::size_t i = 0; i < n; i++)
+      result.x[i] += s[i];
+    f(result.x, fnew);
+    result.evaluations++;
+    T ss = 0;
+    for (std::size_t i = 0; i < n; i++)
+      ss += s[i] * s[i];
+    result.residual = std::sqrt(ss);
+    if (ss > 0) {
+      for (std::size_t i = 0; i < n; i++) {
+        T Bs = 0;
+        for (std::size_t j = 0; j < n; j++)
+          Bs += B[i * n + j] * s[j];
+        const T u = (fnew[i] - fx[i] - Bs) / ss;
+        for (std::size_t j = 0; j < n; j++)
+          B[i * n + j] += u * s[j];
+      }
+    }
+    std::swap(fx, fnew);
+    return true;
+  }, precision, max_iter);
+  return result;
+}
+
+// INTERPOLATION
+
+// LAGRANGE POLYNOMIAL THROUGH (xval[j], fval[j]) OVER ANY INDEXABLE CONTAINERS
+template <typename T = double, typename XS, typename FS>
+T lagrange(const T x, const XS& xval, const FS& fval) {
+  const std::size_t n = xval.size();
+  T sum = 0;
+  for (std::size_t j = 0; j < n; j++) {
+    T product = fval[j];
+    for (std::size_t k = 0; k < n; k++) {
+      if (k != j)
+        product *= (x - xval[k]) / (xval[j] - xval[k]);
+    }
+    sum += product;
+  }
+  return sum;
+}
+
+// BARYCENTRIC LAGRANGE INTERPOLANT (SEE struct BarycentricInterpolant) WITH N NODES FIXED AT
+// COMPILE TIME, OR N = 0 FOR A RUN-TIME NODE COUNT. WITH N > 0, xval AND npoints MUST GIVE
+// EXACTLY N NODES
+template <typename T = double, std::size_t N = 0>
+class Barycentric {
+public:
+  // ARBITRARY NODES: O(n^2) WEIGHTS. fval MUST HOLD AT LEAST AS MANY VALUES AS xval HAS NODES
+  template <typename XS, typename FS>
+  Barycentric(const XS& xval, const FS& fval) : Barycentric(xval.size()) {
+    for (std::size_t j = 0; j < n_; j++) {
+      x_[j] = xval[j];
+      f_[j] = fval[j];
+    }
+    for (std::size_t j = 0; j < n_; j++) {
+      T product = 1;
+      for (std::size_t k = 0; k < n_; k++) {
+        if (k != j)
+          product *= x_[j] - x_[k];
+      }
+      w_[j] = 1 / product;
+    }
+  }
+
+  // SAMPLES ANY CALLABLE AT THE CHEBYSHEV POINTS OF THE SECOND KIND ON [a, b]
+  template <typename F>
+  static Barycentric chebyshev(F&& f, const T a, const T b, const std::size_t npoints = N) {
+    Barycentric interpolant(npoints);
+    const T pi = std::acos(T(-1));
+    for (std::size_t j = 0; j < npoints; j++) {
+      interpolant.x_[j] = (npoints > 1) ? (a + b) / 2 + (b - a) / 2 * std::cos(pi * j / (npoints - 1)) : (a + b) / 2;
+      interpolant.f_[j] = static_cast<T>(f(interpolant.x_[j]));
+      interpolant.w_[j] = (j % 2) ? T(-1) : T(1);
+      if (j == 0 || j == npoints - 1)
+        interpolant.w_[j] /= 2;
+    }
+    return interpolant;
+  }
+
+  T operator()(const T x) const {
+    T numerator = 0, denominator = 0;
+    for (std::size_t j = 0; j < n_; j++) {
+      const T d = x - x_[j];
+      if (d == 0)
+        return f_[j];
+      const T t = w_[j] / d;
+      numerator += t * f_[j];
+      denominator += t;
+    }
+    return numerator / denominator;
+  }
+
+  std::size_t size() const { return n_; }
+
+private:
+  explicit Barycentric(const std::size_t npoints) : n_(npoints), x_(detail::Storage<T, N>::make_vector(npoints)), f_(detail::Storage<T, N>::make_vector(npoints)), w_(detail::Storage<T, N>::make_vector(npoints)) {}
+
+  std::size_t n_;
+  Vector<T, N> x_;
+  Vector<T, N> f_;
+  Vector<T, N> w_;
+};
+
+} // namespace nummet
+
+#endif /* nummet_hpp */
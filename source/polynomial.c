@@ -0,0 +1,247 @@
+//
+//  polynomial.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <pthread.h>
+#include "polynomial.h"
+#include "definitions.h"
+#include "solver.h"
+#include "matrixkernels.h"
+
+#define POLYNOMIAL_MAX_ITER 200
+#define POLISH_MAX_ITER 100
+#define MULLER_MAX_HALVINGS 30
+#define MULLER_GROWTH 10.0
+
+// NEXT MÜLLER ITERATE FROM THREE POINTS x[0..2] (x[2] THE NEWEST) AND THEIR VALUES fx[0..2]
+static double complex muller_next(const double complex* x, const double complex* fx) {
+  const double complex lambda0 = (x[2] - x[1]) / (x[1] - x[0]);
+  const double complex delta = 1 + lambda0;
+  const double complex g = fx[0] * lambda0 * lambda0 - fx[1] * delta * delta + fx[2] * (lambda0 + delta);
+  const double complex root = csqrt(g * g - 4 * fx[2] * delta * lambda0 * (fx[0] * lambda0 - fx[1] * delta + fx[2]));
+  const double complex denominator = (cabs(g + root) >= cabs(g - root)) ? g + root : g - root;
+  // A VANISHING DENOMINATOR MEANS THE PARABOLA IS FLAT: TAKE A FULL STEP INSTEAD
+  const double complex lambda1 = (denominator != 0) ? -2 * fx[2] * delta / denominator : 1;
+  return x[2] + lambda1 * (x[2] - x[1]);
+}
+
+struct ComplexContext {
+  complex_function f;
+  double complex x[3];
+  double complex fx[3];
+  double complex root;
+};
+
+static bool muller_complex_step(void* ptr, struct SolverState* state) {
+  struct ComplexContext* c = ptr;
+  const double complex next = muller_next(c->x, c->fx);
+  state->residual = cabs(next - c->x[2]);
+  c->x[0] = c->x[1];
+  c->x[1] = c->x[2];
+  c->x[2] = next;
+  c->fx[0] = c->fx[1];
+  c->fx[1] = c->fx[2];
+  c->fx[2] = c->f(next);
+  state->evaluations++;
+  state->value = cabs(c->fx[2]);
+  c->root = next;
+  return true;
+}
+
+double complex muller_complex(const complex_function f, const double complex x2, const double complex x1, const double complex x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  struct ComplexContext context = { f, { x0, x1, x2 }, { f(x0), f(x1), f(x2) }, x2 };
+  state->evaluations += 3;
+  // THE ITERATE IS SHOWN AS ITS (REAL, IMAGINARY) PAIR
+  const struct Solver solver = { "Complex Müller's process", muller_complex_step, &context, (const double*) &context.root, 2 };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  return context.root;
+}
+
+// p(x) BY HORNER'S RULE, WITH p'(x) IN derivative WHEN IT IS NOT NULL
+static double complex horner(const double complex* p, const unsigned int degree, const double complex x, double complex* derivative) {
+  double complex value = p[0], slope = 0;
+  for (unsigned int i = 1; i <= degree; i++) {
+    slope = slope * x + value;
+    value = value * x + p[i];
+  }
+  if (derivative)
+    *derivative = slope;
+  return value;
+}
+
+// DIVIDES p (DEGREE degree) BY (x - root) IN PLACE, LEAVING THE QUOTIENT IN p[0..degree-1]
+static void deflate(double complex* p, const unsigned int degree, const double complex root) {
+  for (unsigned int i = 1; i < degree; i++)
+    p[i] += p[i - 1] * root;
+}
+
+// MÜLLER ON THE DEFLATED POLYNOMIAL, STARTING NEAR THE ORIGIN SO THE SMALLEST ROOTS ARE
+// DEFLATED FIRST. CLUSTERED ROOTS MAY NEVER MEET THE STEP TOLERANCE: THE ITERATE WITH THE
+// SMALLEST |p| IS THEN KEPT AND LEFT TO THE POLISHING STAGE. FAILS ONLY ON OVERFLOW
+static bool polynomial_muller(const double complex* p, const unsigned int degree, const double precision, double complex* root) {
+  double complex x[3] = { 0.5, -0.5, 0 };
+  double complex fx[3];
+  for (unsigned int k = 0; k < 3; k++)
+    fx[k] = horner(p, degree, x[k], NULL);
+  double complex best = x[2];
+  double bestValue = cabs(fx[2]);
+  for (unsigned int iter = 0; iter < POLYNOMIAL_MAX_ITER && bestValue != 0; iter++) {
+    double complex next = muller_next(x, fx);
+    if (!isfinite(creal(next)) || !isfinite(cimag(next)))
+      break;
+    // UNSAFEGUARDED MÜLLER CAN CYCLE BETWEEN FAR-OFF PARABOLA ROOTS: HALVE THE STEP WHILE |p| GROWS
+    double complex value = horner(p, degree, next, NULL);
+    for (unsigned int halving = 0; halving < MULLER_MAX_HALVINGS && cabs(value) > MULLER_GROWTH * cabs(fx[2]); halving++) {
+      next = 0.5 * (next + x[2]);
+      value = horner(p, degree, next, NULL);
+    }
+    const double step = cabs(next - x[2]);
+    x[0] = x[1];
+    x[1] = x[2];
+    x[2] = next;
+    fx[0] = fx[1];
+    fx[1] = fx[2];
+    fx[2] = value;
+    if (cabs(fx[2]) <= bestValue) {
+      best = next;
+      bestValue = cabs(fx[2]);
+    }
+    if (step <= precision * fmax(1, cabs(next)))
+      break;
+  }
+  *root = best;
+  return isfinite(bestValue);
+}
+
+// A ROOT IS TAKEN AS REAL WHEN ITS IMAGINARY PART IS BELOW THE TOLERANCE OR DROPPING IT DOES
+// NOT MAKE p ANY LARGER; A SPURIOUS PAIR WOULD OTHERWISE DEFLATE A REAL ROOT TWICE
+static double complex snap_to_real(const double complex* p, const unsigned int degree, const double complex root, const double precision) {
+  if (cimag(root) == 0)
+    return root;
+  if (fabs(cimag(root)) <= precision * fmax(1, cabs(root)) || cabs(horner(p, degree, creal(root), NULL)) <= cabs(horner(p, degree, root, NULL)))
+    return creal(root);
+  return root;
+}
+
+// NEWTON'S METHOD ON THE ORIGINAL POLYNOMIAL. CONVERGENCE IS ONLY LINEAR AT A MULTIPLE ROOT,
+// SO IT RUNS UNTIL THE STEP IS BELOW THE TOLERANCE OR |p| STOPS DECREASING
+static double complex polish(const double complex* p, const unsigned int degree, double complex root, const double precision) {
+  double complex slope;
+  double complex value = horner(p, degree, root, &slope);
+  for (unsigned int iter = 0; iter < POLISH_MAX_ITER && value != 0 && slope != 0; iter++) {
+    const double complex step = value / slope;
+    double complex nextSlope;
+    const double complex next = root - step;
+    const double complex nextValue = horner(p, degree, next, &nextSlope);
+    if (!(cabs(nextValue) < cabs(value)))
+      break;
+    root = next;
+    value = nextValue;
+    slope = nextSlope;
+    if (cabs(step) <= precision * fmax(1, cabs(root)))
+      break;
+  }
+  return root;
+}
+
+static int compare_complex(const void* p, const void* q) {
+  const double complex a = *(const double complex*) p, b = *(const double complex*) q;
+  if (creal(a) != creal(b))
+    return (creal(a) > creal(b)) - (creal(a) < creal(b));
+  return (cimag(a) > cimag(b)) - (cimag(a) < cimag(b));
+}
+
+unsigned int polynomial_roots(const double* coefficients, unsigned int degree, double complex* roots, const double precision) {
+  while (degree && coefficients[0] == 0) {
+    coefficients++;
+    degree--;
+  }
+  double complex original[degree + 1], work[degree + 1];
+  for (unsigned int i = 0; i <= degree; i++)
+    original[i] = work[i] = coefficients[i];
+  unsigned int found = 0, remaining = degree;
+  while (remaining) {
+    double complex root;
+    if (work[remaining] == 0)
+      root = 0;
+    else if (remaining == 1)
+      root = -work[1] / work[0];
+    else if (!polynomial_muller(work, remaining, precision, &root))
+      break;
+    root = snap_to_real(work, remaining, root, precision);
+    roots[found++] = root;
+    deflate(work, remaining--, root);
+    // REAL COEFFICIENTS: A COMPLEX ROOT BRINGS ITS CONJUGATE, DEFLATED TOGETHER
+    if (cimag(root) != 0 && remaining) {
+      roots[found++] = conj(root);
+      deflate(work, remaining--, conj(root));
+    }
+  }
+  for (unsigned int k = 0; k < found; k++) {
+    const bool real = cimag(roots[k]) == 0;
+    roots[k] = polish(original, degree, roots[k], precision);
+    if (real)
+      roots[k] = creal(roots[k]);
+  }
+  qsort(roots, found, sizeof(double complex), compare_complex);
+  return found;
+}
+
+struct PolynomialTask {
+  const double* coefficients;
+  unsigned int degree;
+  unsigned int first;
+  unsigned int last;
+  double complex* roots;
+  unsigned int* found;
+  double precision;
+};
+
+static void* polynomial_thread(void* ptr) {
+  const struct PolynomialTask* task = ptr;
+  for (unsigned int k = task->first; k < task->last; k++) {
+    const unsigned int n = polynomial_roots(task->coefficients + (size_t) k * (task->degree + 1), task->degree, task->roots + (size_t) k * task->degree, task->precision);
+    if (task->found)
+      task->found[k] = n;
+  }
+  return NULL;
+}
+
+void polynomial_roots_batch(const double* coefficients, const unsigned int degree, const unsigned int count, double complex* roots, unsigned int* found, const double precision, const unsigned int nthreads) {
+  unsigned int ntasks = nthreads ? nthreads : get_matrix_threads();
+  if (ntasks > count)
+    ntasks = count;
+  if (!ntasks)
+    return;
+  struct PolynomialTask tasks[ntasks];
+  pthread_t threads[ntasks];
+  for (unsigned int t = 0; t < ntasks; t++) {
+    struct PolynomialTask task = { coefficients, degree, (unsigned int) ((unsigned long) count * t / ntasks), (unsigned int) ((unsigned long) count * (t + 1) / ntasks), roots, found, precision };
+    tasks[t] = task;
+  }
+  unsigned int t = 1;
+  for (; t < ntasks; t++) {
+    if (pthread_create(&threads[t], NULL, polynomial_thread, &tasks[t]))
+      break;
+  }
+  polynomial_thread(&tasks[0]);
+  for (unsigned int u = 1; u < t; u++)
+    pthread_join(threads[u], NULL);
+  for (; t < ntasks; t++)
+    polynomial_thread(&tasks[t]);
+}
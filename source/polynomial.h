@@ -0,0 +1,37 @@
+//
+//  polynomial.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef polynomial_h
+#define polynomial_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <complex.h>
+#include "definitions.h"
+#include "solver.h"
+
+typedef double complex (*complex_function)(const double complex);
+
+// MÜLLER'S PROCESS IN COMPLEX ARITHMETIC, SO A NEGATIVE DISCRIMINANT SIMPLY LEADS TO A
+// COMPLEX ROOT. ONE CALL TO f PER ITERATION AFTER THE THREE STARTING POINTS
+double complex muller_complex(const complex_function f, const double complex x2, const double complex x1, const double complex x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// ALL ROOTS OF p(x) = coefficients[0] x^degree + coefficients[1] x^(degree - 1) + ... + coefficients[degree]
+// EACH ROOT IS FOUND BY COMPLEX MÜLLER ON THE DEFLATED POLYNOMIAL (A COMPLEX ROOT IS DEFLATED
+// TOGETHER WITH ITS CONJUGATE), THEN EVERY ROOT IS POLISHED BY NEWTON'S METHOD ON p ITSELF.
+// roots RECEIVES THE ROOTS SORTED BY REAL, THEN IMAGINARY PART; ROOTS WITHIN ROUNDING OF THE
+// REAL AXIS ARE MADE REAL. RETURNS THE NUMBER OF ROOTS FOUND (THE DEGREE ONCE LEADING ZERO
+// COEFFICIENTS ARE DROPPED, FEWER IF AN ITERATION FAILED)
+unsigned int polynomial_roots(const double* coefficients, const unsigned int degree, double complex* roots, const double precision);
+
+// polynomial_roots FOR count POLYNOMIALS OF THE SAME degree, SPLIT ACROSS nthreads THREADS
+// (0 MEANS ONE PER ONLINE CPU). POLYNOMIAL k HAS ITS COEFFICIENTS AT coefficients[k * (degree + 1)]
+// AND ITS ROOTS AT roots[k * degree]; found (MAY BE NULL) RECEIVES EACH RETURN VALUE
+void polynomial_roots_batch(const double* coefficients, const unsigned int degree, const unsigned int count, double complex* roots, unsigned int* found, const double precision, const unsigned int nthreads);
+
+#endif /* polynomial_h */
@@ -0,0 +1,224 @@
+//
+//  rootscan.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "rootscan.h"
+#include "definitions.h"
+#include "solver.h"
+#include "unisolvers.h"
+#include "matrixkernels.h"
+
+#define ROOT_SCAN_MAX_ITER 200
+#define GOLDEN_RATIO 0.6180339887498949
+
+// ROOTS FOUND BY ONE THREAD
+struct RootBuffer {
+  double* roots;
+  unsigned int count;
+  unsigned int capacity;
+  unsigned long evaluations;
+};
+
+struct ScanTask {
+  univariate_function f;
+  const double* x;
+  double* fx;
+  unsigned int first;
+  unsigned int last;
+  unsigned int npoints;
+  double precision;
+  double ftolerance;
+  struct RootBuffer found;
+};
+
+static void add_root(struct RootBuffer* buffer, const double root) {
+  if (buffer->count == buffer->capacity) {
+    buffer->capacity = buffer->capacity ? 2 * buffer->capacity : 16;
+    buffer->roots = realloc(buffer->roots, buffer->capacity * sizeof(double));
+  }
+  buffer->roots[buffer->count++] = root;
+}
+
+// POLISHES A SIGN CHANGE, REJECTING POLES (WHERE |f| GROWS INSTEAD OF VANISHING)
+static void polish_bracket(struct ScanTask* task, const double x0, const double f0, const double x1, const double f1) {
+  struct SolverState state;
+  const double root = brent(task->f, x0, x1, ROOT_SCAN_MAX_ITER, task->precision, false, &state);
+  task->found.evaluations += state.evaluations;
+  if (state.termination == SOLVER_CONVERGED && fabs(state.value) <= fmax(fabs(f0), fabs(f1)))
+    add_root(&task->found, root);
+}
+
+// MINIMISES |f| ON [x0, x1] BY GOLDEN SECTION AND KEEPS THE MINIMUM IF IT TOUCHES ZERO
+static void polish_touching(struct ScanTask* task, double x0, double x1) {
+  const univariate_function f = task->f;
+  double u = x1 - GOLDEN_RATIO * (x1 - x0), v = x0 + GOLDEN_RATIO * (x1 - x0);
+  double fu = fabs(f(u)), fv = fabs(f(v));
+  task->found.evaluations += 2;
+  while (x1 - x0 > task->precision) {
+    if (fu < fv) {
+      x1 = v;
+      v = u;
+      fv = fu;
+      u = x1 - GOLDEN_RATIO * (x1 - x0);
+      fu = fabs(f(u));
+    } else {
+      x0 = u;
+      u = v;
+      fu = fv;
+      v = x0 + GOLDEN_RATIO * (x1 - x0);
+      fv = fabs(f(v));
+    }
+    task->found.evaluations++;
+  }
+  if (fmin(fu, fv) <= task->ftolerance)
+    add_root(&task->found, (fu < fv) ? u : v);
+}
+
+static bool local_minimum(const double* fx, const unsigned int i, const unsigned int npoints) {
+  return i > 0 && i + 1 < npoints && fabs(fx[i]) <= fabs(fx[i - 1]) && fabs(fx[i]) <= fabs(fx[i + 1]) && fx[i - 1] * fx[i] > 0 && fx[i] * fx[i + 1] > 0;
+}
+
+// AT THE ENDS OF A GRID ONLY THE NEIGHBOUR THAT EXISTS IS COMPARED
+static bool steep(const double* fx, const unsigned int i, const unsigned int npoints) {
+  const bool left = i > 0, right = i + 2 < npoints;
+  const double change = fabs(fx[i + 1] - fx[i]);
+  return (left || right) && (!left || change > ROOT_SCAN_STEEPNESS * fabs(fx[i] - fx[i - 1])) && (!right || change > ROOT_SCAN_STEEPNESS * fabs(fx[i + 2] - fx[i + 1]));
+}
+
+// SIGNS ALTERNATING ACROSS THREE CONSECUTIVE INTERVALS MEAN f OSCILLATES FASTER THAN THE GRID
+static bool oscillating(const double* fx, const unsigned int i, const unsigned int npoints) {
+  return i > 0 && i + 2 < npoints && fx[i - 1] * fx[i] < 0 && fx[i] * fx[i + 1] < 0 && fx[i + 1] * fx[i + 2] < 0;
+}
+
+// SCANS THE INTERVALS [x[i], x[i + 1]] FOR first <= i < last OF A GRID OF npoints POINTS
+static void scan_grid(struct ScanTask* task, const double* x, const double* fx, const unsigned int first, const unsigned int last, const unsigned int npoints, const unsigned int depth) {
+  for (unsigned int i = first; i < last; i++) {
+    if (fx[i] == 0) {
+      add_root(&task->found, x[i]);
+      continue;
+    }
+    // A STEEP INTERVAL MAY HIDE SEVERAL ROOTS EVEN WHEN ITS ENDS CHANGE SIGN
+    const bool refine = depth < ROOT_SCAN_MAX_DEPTH && (steep(fx, i, npoints) || oscillating(fx, i, npoints) || local_minimum(fx, i, npoints) || local_minimum(fx, i + 1, npoints));
+    if (!refine) {
+      if (fx[i] * fx[i + 1] < 0)
+        polish_bracket(task, x[i], fx[i], x[i + 1], fx[i + 1]);
+      else if (depth == ROOT_SCAN_MAX_DEPTH && local_minimum(fx, i, npoints))
+        polish_touching(task, x[i - 1], x[i + 1]);
+      continue;
+    }
+    double xs[ROOT_SCAN_SUBDIVISIONS + 1], fs[ROOT_SCAN_SUBDIVISIONS + 1];
+    const double h = (x[i + 1] - x[i]) / ROOT_SCAN_SUBDIVISIONS;
+    xs[0] = x[i];
+    fs[0] = fx[i];
+    xs[ROOT_SCAN_SUBDIVISIONS] = x[i + 1];
+    fs[ROOT_SCAN_SUBDIVISIONS] = fx[i + 1];
+    for (unsigned int k = 1; k < ROOT_SCAN_SUBDIVISIONS; k++) {
+      xs[k] = x[i] + k * h;
+      fs[k] = task->f(xs[k]);
+    }
+    task->found.evaluations += ROOT_SCAN_SUBDIVISIONS - 1;
+    scan_grid(task, xs, fs, 0, ROOT_SCAN_SUBDIVISIONS, ROOT_SCAN_SUBDIVISIONS + 1, depth + 1);
+  }
+}
+
+static void* sample_thread(void* ptr) {
+  struct ScanTask* task = ptr;
+  for (unsigned int i = task->first; i <= task->last; i++)
+    task->fx[i] = task->f(task->x[i]);
+  task->found.evaluations += task->last - task->first + 1;
+  return NULL;
+}
+
+static void* scan_thread(void* ptr) {
+  struct ScanTask* task = ptr;
+  scan_grid(task, task->x, task->fx, task->first, task->last, task->npoints, 0);
+  return NULL;
+}
+
+static void run_scan_tasks(void* (*work)(void*), struct ScanTask* tasks, const unsigned int nthreads) {
+  pthread_t threads[nthreads];
+  unsigned int t = 1;
+  for (; t < nthreads; t++) {
+    if (pthread_create(&threads[t], NULL, work, &tasks[t]))
+      break;
+  }
+  work(&tasks[0]);
+  for (unsigned int u = 1; u < t; u++)
+    pthread_join(threads[u], NULL);
+  for (; t < nthreads; t++)
+    work(&tasks[t]);
+}
+
+static int compare_roots(const void* p, const void* q) {
+  const double a = *(const double*) p, b = *(const double*) q;
+  return (a > b) - (a < b);
+}
+
+struct RootList* find_all_roots(const univariate_function f, const double a, const double b, const unsigned int samples, const double precision, const double ftolerance, const unsigned int nthreads) {
+  if (!(a < b) || samples == 0) {
+    fprintf(stderr, "ERROR: Invalid interval provided\n");
+    exit(1);
+  }
+  const unsigned int npoints = samples + 1;
+  unsigned int nchunks = nthreads ? nthreads : get_matrix_threads();
+  if (nchunks > samples)
+    nchunks = samples;
+  double* x = malloc(2 * (size_t) npoints * sizeof(double));
+  double* fx = x + npoints;
+  for (unsigned int i = 0; i < npoints; i++)
+    x[i] = (i == samples) ? b : a + (b - a) * i / samples;
+  // CHUNK t SAMPLES POINTS [first, last] AND LATER SCANS INTERVALS [first, last)
+  struct ScanTask tasks[nchunks];
+  for (unsigned int t = 0; t < nchunks; t++) {
+    struct ScanTask task = { f, x, fx, (unsigned int) ((unsigned long) samples * t / nchunks), (unsigned int) ((unsigned long) samples * (t + 1) / nchunks), npoints, precision, ftolerance, { NULL, 0, 0, 0 } };
+    tasks[t] = task;
+    if (t)
+      tasks[t].first++;
+  }
+  run_scan_tasks(sample_thread, tasks, nchunks);
+  for (unsigned int t = 1; t < nchunks; t++)
+    tasks[t].first--;
+  run_scan_tasks(scan_thread, tasks, nchunks);
+  struct RootList* list = malloc(sizeof(struct RootList));
+  list->count = 0;
+  list->evaluations = 0;
+  unsigned int total = 0;
+  for (unsigned int t = 0; t < nchunks; t++)
+    total += tasks[t].found.count;
+  // THE LAST SAMPLE IS THE ONLY ONE NO INTERVAL STARTS AT
+  list->roots = malloc((total + 1) * sizeof(double));
+  if (fx[samples] == 0)
+    list->roots[total++] = b;
+  for (unsigned int t = 0, k = 0; t < nchunks; t++) {
+    for (unsigned int j = 0; j < tasks[t].found.count; j++)
+      list->roots[k++] = tasks[t].found.roots[j];
+    list->evaluations += tasks[t].found.evaluations;
+    free(tasks[t].found.roots);
+  }
+  qsort(list->roots, total, sizeof(double), compare_roots);
+  // ROOTS CLOSER THAN THE REQUESTED PRECISION ARE THE SAME ROOT FOUND FROM NEIGHBOURING INTERVALS
+  for (unsigned int k = 0; k < total; k++) {
+    if (list->count && list->roots[k] - list->roots[list->count - 1] <= 2 * precision)
+      continue;
+    list->roots[list->count++] = list->roots[k];
+  }
+  free(x);
+  return list;
+}
+
+void destroy_root_list(struct RootList* list) {
+  if (!list)
+    return;
+  free(list->roots);
+  free(list);
+}
@@ -0,0 +1,42 @@
+//
+//  rootscan.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef rootscan_h
+#define rootscan_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// A SUSPICIOUS INTERVAL IS SPLIT INTO THIS MANY PIECES, AT MOST ROOT_SCAN_MAX_DEPTH TIMES
+#define ROOT_SCAN_SUBDIVISIONS 8
+#define ROOT_SCAN_MAX_DEPTH 4
+
+// AN INTERVAL IS REFINED WHEN f CHANGES THIS MANY TIMES FASTER ACROSS IT THAN ACROSS BOTH
+// OF ITS NEIGHBOURS
+#define ROOT_SCAN_STEEPNESS 8.0
+
+// ROOTS FOUND BY find_all_roots, SORTED AND WITHOUT DUPLICATES
+struct RootList {
+  double* roots;
+  unsigned int count;
+  unsigned long evaluations;
+};
+
+// FINDS EVERY ROOT OF f IN [a, b]
+// f IS SAMPLED AT samples + 1 EQUISPACED POINTS, SPLIT INTO CHUNKS ACROSS nthreads THREADS
+// (0 MEANS ONE PER ONLINE CPU), SO f MUST BE SAFE TO CALL CONCURRENTLY. EVERY SIGN CHANGE IS
+// POLISHED WITH BRENT'S METHOD TO precision. INTERVALS WHERE |f| HAS A LOCAL MINIMUM OR f
+// CHANGES UNUSUALLY FAST OR OSCILLATES FROM SAMPLE TO SAMPLE ARE SUBDIVIDED TO FIND CLOSE ROOTS; A MINIMUM OF |f| THAT
+// NEVER CROSSES ZERO COUNTS AS A (DOUBLE) ROOT WHEN |f| THERE IS AT MOST ftolerance.
+// SIGN CHANGES ACROSS POLES ARE DISCARDED
+struct RootList* find_all_roots(const univariate_function f, const double a, const double b, const unsigned int samples, const double precision, const double ftolerance, const unsigned int nthreads);
+
+void destroy_root_list(struct RootList* list);
+
+#endif /* rootscan_h */
@@ -0,0 +1,59 @@
+//
+//  scalar.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "scalar.h"
+#include "definitions.h"
+#include "solver.h"
+#include "interpolation.h"
+#if SCALAR_FLOAT128
+#include <quadmath.h>
+#endif
+
+#define SCALAR float
+#define SCALAR_SUFFIX f
+#define SCALAR_EPSILON FLT_EPSILON
+#define SCALAR_FABS fabsf
+#define SCALAR_SQRT sqrtf
+#include "scalarkernels.h"
+#undef SCALAR
+#undef SCALAR_SUFFIX
+#undef SCALAR_EPSILON
+#undef SCALAR_FABS
+#undef SCALAR_SQRT
+
+#define SCALAR long double
+#define SCALAR_SUFFIX l
+#define SCALAR_EPSILON LDBL_EPSILON
+#define SCALAR_FABS fabsl
+#define SCALAR_SQRT sqrtl
+#include "scalarkernels.h"
+#undef SCALAR
+#undef SCALAR_SUFFIX
+#undef SCALAR_EPSILON
+#undef SCALAR_FABS
+#undef SCALAR_SQRT
+
+#if SCALAR_FLOAT128
+#define SCALAR __float128
+#define SCALAR_SUFFIX q
+#define SCALAR_EPSILON FLT128_EPSILON
+#define SCALAR_FABS fabsq
+#define SCALAR_SQRT sqrtq
+#include "scalarkernels.h"
+#undef SCALAR
+#undef SCALAR_SUFFIX
+#undef SCALAR_EPSILON
+#undef SCALAR_FABS
+#undef SCALAR_SQRT
+#endif
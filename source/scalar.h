@@ -0,0 +1,62 @@
+//
+//  scalar.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef scalar_h
+#define scalar_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+#include "solver.h"
+#include "interpolation.h"
+
+// THE VECTOR KERNELS, DIFFERENCE TABLES, INTERPOLATION PLANS AND THE BISECTION, NEWTON AND
+// SECANT SOLVERS ARE GENERATED FROM ONE SOURCE (scalarkernels.h) FOR EACH SCALAR TYPE BELOW.
+// EVERY NAME TAKES THE SUFFIX OF ITS TYPE, AS IN <math.h>:
+//   _f  float          (inner_product_f, struct DifferenceTable_f, newton_f, ...)
+//   _l  long double
+//   _q  __float128     (BUILD WITH -DSCALAR_FLOAT128=1 AND LINK -lquadmath)
+// THE double VERSIONS ARE THE UNSUFFIXED ROUTINES OF THE REST OF THE LIBRARY, BUILT FROM THE
+// SAME TABLE, PLAN AND SOLVER TEMPLATES (scalartable.h, scalarplan.h, scalarsolvers.h); ONLY
+// THEIR VECTOR KERNELS ARE SEPARATE, DISPATCHED BY INSTRUCTION SET (vectorkernels.h)
+//
+// TOLERANCES FOLLOW THE TYPE: A STEP BELOW A FEW UNITS IN THE LAST PLACE OF THE ITERATE
+// COUNTS AS CONVERGED, AND precision 0 STANDS FOR THE EPSILON OF THE TYPE
+#ifndef SCALAR_FLOAT128
+#define SCALAR_FLOAT128 0
+#endif
+
+#if SCALAR_FLOAT128 && !defined(__SIZEOF_FLOAT128__)
+#error "__float128 is not supported by this compiler"
+#endif
+
+#define SCALAR_CONCAT_(name, suffix) name##_##suffix
+#define SCALAR_CONCAT(name, suffix) SCALAR_CONCAT_(name, suffix)
+#define SCALAR_NAME(name) SCALAR_CONCAT(name, SCALAR_SUFFIX)
+
+#define SCALAR float
+#define SCALAR_SUFFIX f
+#include "scalarapi.h"
+#undef SCALAR
+#undef SCALAR_SUFFIX
+
+#define SCALAR long double
+#define SCALAR_SUFFIX l
+#include "scalarapi.h"
+#undef SCALAR
+#undef SCALAR_SUFFIX
+
+#if SCALAR_FLOAT128
+#define SCALAR __float128
+#define SCALAR_SUFFIX q
+#include "scalarapi.h"
+#undef SCALAR
+#undef SCALAR_SUFFIX
+#endif
+
+#endif /* scalar_h */
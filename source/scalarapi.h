@@ -0,0 +1,54 @@
+//
+//  scalarapi.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Declarations for one scalar type, included by scalar.h once per type with SCALAR and
+//  SCALAR_SUFFIX defined. No include guard on purpose.
+//
+
+typedef SCALAR (*SCALAR_NAME(univariate_function))(const SCALAR);
+
+// VECTOR KERNELS
+SCALAR SCALAR_NAME(inner_product)(const SCALAR* v1, const SCALAR* v2, const unsigned int dim);
+
+SCALAR SCALAR_NAME(difference_norm)(const SCALAR* v1, const SCALAR* v2, const unsigned int dim);
+
+// FORWARD DIFFERENCES, LAID OUT AS IN struct DifferenceTable
+struct SCALAR_NAME(DifferenceTable) {
+  SCALAR* table;
+  unsigned long npoints;
+  unsigned int degree;
+};
+
+struct SCALAR_NAME(DifferenceTable)* SCALAR_NAME(new_difference_table_degree)(const SCALAR* val, const unsigned int npoints, const unsigned int degree);
+
+void SCALAR_NAME(destroy_difference_table)(struct SCALAR_NAME(DifferenceTable)* table);
+
+SCALAR SCALAR_NAME(difference)(const struct SCALAR_NAME(DifferenceTable)* table, const unsigned int index, const unsigned int degree);
+
+// COMPILED FINITE-DIFFERENCE FORMULA, AS IN struct InterpolationPlan
+struct SCALAR_NAME(InterpolationPlan) {
+  enum InterpolationFormula formula;
+  unsigned int degree;
+  SCALAR x0;
+  SCALAR h_width;
+  SCALAR* coefficients;
+};
+
+struct SCALAR_NAME(InterpolationPlan)* SCALAR_NAME(new_interpolation_plan)(const struct SCALAR_NAME(DifferenceTable)* table, const SCALAR* xval, const SCALAR* fval, const enum InterpolationFormula formula, const unsigned int degree, const unsigned int index, const SCALAR h_width);
+
+void SCALAR_NAME(destroy_interpolation_plan)(struct SCALAR_NAME(InterpolationPlan)* plan);
+
+SCALAR SCALAR_NAME(interpolation_plan_eval)(const struct SCALAR_NAME(InterpolationPlan)* plan, const SCALAR xinput);
+
+void SCALAR_NAME(interpolation_plan_batch)(const struct SCALAR_NAME(InterpolationPlan)* plan, const SCALAR* xinput, SCALAR* output, const unsigned int ninputs);
+
+// UNIVARIATE SOLVERS WITH THE SIGNATURES OF unisolvers.h
+SCALAR SCALAR_NAME(bisection)(const SCALAR_NAME(univariate_function) f, const SCALAR x0, const SCALAR x1, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state);
+
+SCALAR SCALAR_NAME(newton)(const SCALAR_NAME(univariate_function) f, const SCALAR_NAME(univariate_function) fp, const SCALAR x0, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state);
+
+SCALAR SCALAR_NAME(secant)(const SCALAR_NAME(univariate_function) f, const SCALAR x1, const SCALAR x0, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state);
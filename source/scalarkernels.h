@@ -0,0 +1,32 @@
+//
+//  scalarkernels.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Definitions for one scalar type, included by scalar.c once per type with SCALAR,
+//  SCALAR_SUFFIX, SCALAR_EPSILON, SCALAR_FABS and SCALAR_SQRT defined. No include guard on
+//  purpose. The tables, plans and solvers come from the same templates that definitions.c,
+//  interpolation.c and unisolvers.c instantiate for double; only the vector kernels below
+//  differ, since the double ones are dispatched by instruction set (vectorkernels.c).
+//
+
+// VECTOR KERNELS
+SCALAR SCALAR_NAME(inner_product)(const SCALAR* v1, const SCALAR* v2, const unsigned int dim) {
+  SCALAR val = 0;
+  for (unsigned int i = 0; i < dim; i++)
+    val += v1[i] * v2[i];
+  return val;
+}
+
+SCALAR SCALAR_NAME(difference_norm)(const SCALAR* v1, const SCALAR* v2, const unsigned int dim) {
+  SCALAR val = 0;
+  for (unsigned int i = 0; i < dim; i++)
+    val += (v1[i] - v2[i]) * (v1[i] - v2[i]);
+  return SCALAR_SQRT(val);
+}
+
+#include "scalartable.h"
+#include "scalarplan.h"
+#include "scalarsolvers.h"
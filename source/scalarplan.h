@@ -0,0 +1,176 @@
+//
+//  scalarplan.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Interpolation plans for one scalar type, included with SCALAR and SCALAR_NAME defined:
+//  by interpolation.c for double and through scalarkernels.h for the other types. No include
+//  guard on purpose.
+//
+
+#ifndef scalarplan_helpers
+#define scalarplan_helpers
+// NUMBER OF COEFFICIENTS A PLAN OF THE GIVEN FORMULA AND DEGREE NEEDS
+static unsigned int plan_size(const enum InterpolationFormula formula, const unsigned int degree) {
+  switch (formula) {
+    case STIRLING:
+      return 1 + 2 * ((degree + 1) / 2);
+    case EVERETT:
+      return 2 * (degree / 2 + 1);
+    default:
+      return degree + 1;
+  }
+}
+
+// WHETHER THE NODES THE FORMULA READS AROUND index (index - below TO index + above, AS IN
+// fill_plan_coefficients) ALL LIE IN THE TABLE. CHECKED BEFORE ANY index - k IS FORMED
+static bool stencil_fits(const enum InterpolationFormula formula, const unsigned int degree, const unsigned int index, const unsigned long npoints) {
+  unsigned int below = 0, above = degree;
+  switch (formula) {
+    case NEWTON_ASCENDING:
+      break;
+    case NEWTON_DESCENDING:
+      below = degree;
+      above = 0;
+      break;
+    case STIRLING:
+      below = above = (degree + 1) / 2;
+      break;
+    case EVERETT:
+      below = degree / 2;
+      above = degree / 2 + 1;
+      break;
+  }
+  return index < npoints && index >= below && above <= npoints - 1 - index;
+}
+#endif
+
+// SOURCE OF DIFFERENCES FOR THE PLAN BUILDER: Δ^degree f_index, WITH degree 0 GIVING f_index
+typedef SCALAR (*SCALAR_NAME(difference_lookup))(const void* source, const unsigned int index, const unsigned int degree);
+
+struct SCALAR_NAME(TableSource) {
+  const struct SCALAR_NAME(DifferenceTable)* table;
+  const SCALAR* fval;
+};
+
+static SCALAR SCALAR_NAME(table_lookup)(const void* source, const unsigned int index, const unsigned int degree) {
+  const struct SCALAR_NAME(TableSource)* s = source;
+  return degree ? SCALAR_NAME(difference)(s->table, index, degree) : s->fval[index];
+}
+
+// COLLECTS THE DIFFERENCES THE FORMULA USES, DIVIDED BY THE FACTORIAL OF THE MATCHING
+// BINOMIAL COEFFICIENT, SO EVALUATION ONLY MULTIPLIES BY LINEAR FACTORS IN s
+static void SCALAR_NAME(fill_plan_coefficients)(const SCALAR_NAME(difference_lookup) lookup, const void* source, const enum InterpolationFormula formula, const unsigned int degree, const unsigned int index, SCALAR* coefficients) {
+  SCALAR inverseFactorial = 1;
+  switch (formula) {
+    case NEWTON_ASCENDING:
+    case NEWTON_DESCENDING:
+      coefficients[0] = lookup(source, index, 0);
+      for (unsigned int k = 1; k <= degree; k++) {
+        inverseFactorial /= k;
+        coefficients[k] = inverseFactorial * lookup(source, formula == NEWTON_ASCENDING ? index : index - k, k);
+      }
+      break;
+    case STIRLING:
+      // [f, o_0, e_0, o_1, e_1, ...] WITH o_m THE MEAN ODD DIFFERENCE / (2m + 1)! AND e_m
+      // THE EVEN DIFFERENCE / (2m + 2)!
+      coefficients[0] = lookup(source, index, 0);
+      for (unsigned int k = 1; k < plan_size(formula, degree); k++) {
+        const unsigned int m = (k - 1) / 2;
+        inverseFactorial /= k;
+        if (k > degree)
+          coefficients[k] = 0;
+        else if (k % 2)
+          coefficients[k] = inverseFactorial * (lookup(source, index - m, k) + lookup(source, index - m - 1, k)) / 2;
+        else
+          coefficients[k] = inverseFactorial * lookup(source, index - m - 1, k);
+      }
+      break;
+    case EVERETT:
+      // [E_0, F_0, E_1, F_1, ...] WITH E_i = δ^2i f_index / (2i + 1)!, F_i LIKEWISE AT index + 1
+      coefficients[0] = lookup(source, index, 0);
+      coefficients[1] = lookup(source, index + 1, 0);
+      for (unsigned int i = 1; i <= degree / 2; i++) {
+        inverseFactorial /= (2 * i) * (2 * i + 1);
+        coefficients[2 * i] = inverseFactorial * lookup(source, index - i, 2 * i);
+        coefficients[2 * i + 1] = inverseFactorial * lookup(source, index + 1 - i, 2 * i);
+      }
+      break;
+  }
+}
+
+// NESTED (HORNER) EVALUATION OF THE FORMULA AT s = (x - x_index) / h
+static inline SCALAR SCALAR_NAME(evaluate_plan_coefficients)(const enum InterpolationFormula formula, const unsigned int degree, const SCALAR* b, const SCALAR s) {
+  SCALAR acc = 0;
+  switch (formula) {
+    case NEWTON_ASCENDING:
+      // b0 + s (b1 + (s - 1) (b2 + (s - 2) (...)))
+      acc = b[degree];
+      for (unsigned int k = degree; k >= 1; k--)
+        acc = b[k - 1] + (s - (SCALAR) (k - 1)) * acc;
+      return acc;
+    case NEWTON_DESCENDING:
+      // b0 + s (b1 + (s + 1) (b2 + (s + 2) (...)))
+      acc = b[degree];
+      for (unsigned int k = degree; k >= 1; k--)
+        acc = b[k - 1] + (s + (SCALAR) (k - 1)) * acc;
+      return acc;
+    case STIRLING: {
+      // f + g_0 + (s^2 - 1) (g_1 + (s^2 - 4) (g_2 + ...)), g_m = s o_m + s^2 e_m
+      const SCALAR s2 = s * s;
+      const unsigned int groups = (degree + 1) / 2;
+      for (unsigned int m = groups; m-- > 0;)
+        acc = s * b[2 * m + 1] + s2 * b[2 * m + 2] + (m + 1 < groups ? (s2 - (SCALAR) (m + 1) * (m + 1)) * acc : 0);
+      return b[0] + acc;
+    }
+    case EVERETT: {
+      // p (E_0 + (p^2 - 1) (E_1 + ...)) + s (F_0 + (s^2 - 1) (F_1 + ...)), p = 1 - s
+      const SCALAR p = 1 - s;
+      const SCALAR p2 = p * p, s2 = s * s;
+      SCALAR accS = 0;
+      for (unsigned int i = degree / 2 + 1; i-- > 0;) {
+        const SCALAR j2 = (SCALAR) (i + 1) * (i + 1);
+        acc = b[2 * i] + (i < degree / 2 ? (p2 - j2) * acc : 0);
+        accS = b[2 * i + 1] + (i < degree / 2 ? (s2 - j2) * accS : 0);
+      }
+      return p * acc + s * accS;
+    }
+  }
+  return acc;
+}
+
+struct SCALAR_NAME(InterpolationPlan)* SCALAR_NAME(new_interpolation_plan)(const struct SCALAR_NAME(DifferenceTable)* table, const SCALAR* xval, const SCALAR* fval, const enum InterpolationFormula formula, const unsigned int degree, const unsigned int index, const SCALAR h_width) {
+  if (degree > table->degree || !stencil_fits(formula, degree, index, table->npoints)) {
+    fprintf(stderr, "ERROR: Invalid degree provided\n");
+    exit(1);
+  }
+  struct SCALAR_NAME(InterpolationPlan)* plan = malloc(sizeof(struct SCALAR_NAME(InterpolationPlan)));
+  plan->formula = formula;
+  plan->degree = degree;
+  plan->x0 = xval[index];
+  plan->h_width = h_width;
+  plan->coefficients = malloc(plan_size(formula, degree) * sizeof(SCALAR));
+  const struct SCALAR_NAME(TableSource) source = { table, fval };
+  SCALAR_NAME(fill_plan_coefficients)(SCALAR_NAME(table_lookup), &source, formula, degree, index, plan->coefficients);
+  return plan;
+}
+
+void SCALAR_NAME(destroy_interpolation_plan)(struct SCALAR_NAME(InterpolationPlan)* plan) {
+  if (!plan)
+    return;
+  free(plan->coefficients);
+  free(plan);
+}
+
+SCALAR SCALAR_NAME(interpolation_plan_eval)(const struct SCALAR_NAME(InterpolationPlan)* plan, const SCALAR xinput) {
+  return SCALAR_NAME(evaluate_plan_coefficients)(plan->formula, plan->degree, plan->coefficients, (xinput - plan->x0) / plan->h_width);
+}
+
+void SCALAR_NAME(interpolation_plan_batch)(const struct SCALAR_NAME(InterpolationPlan)* plan, const SCALAR* xinput, SCALAR* output, const unsigned int ninputs) {
+  const SCALAR x0 = plan->x0;
+  const SCALAR inverseWidth = 1 / plan->h_width;
+  for (unsigned int q = 0; q < ninputs; q++)
+    output[q] = SCALAR_NAME(evaluate_plan_coefficients)(plan->formula, plan->degree, plan->coefficients, (xinput[q] - x0) * inverseWidth);
+}
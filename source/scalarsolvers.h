@@ -0,0 +1,137 @@
+//
+//  scalarsolvers.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Bisection, Newton and secant solvers for one scalar type, included with SCALAR,
+//  SCALAR_NAME, SCALAR_EPSILON and SCALAR_FABS defined: by unisolvers.c for double and
+//  through scalarkernels.h for the other types. No include guard on purpose.
+//
+
+// UNITS IN THE LAST PLACE BELOW WHICH A SOLVER STEP COUNTS AS CONVERGED
+#ifndef SCALAR_ULPS
+#define SCALAR_ULPS 4
+#endif
+
+// run_solver SEES THE ITERATE (THROUGH shown) AND RESIDUAL AS doubles, WHICH FOR THE OTHER
+// TYPES ONLY AFFECTS verbose OUTPUT AND TRACES: THE ITERATION ITSELF RUNS IN SCALAR
+struct SCALAR_NAME(ScalarContext) {
+  SCALAR_NAME(univariate_function) f;
+  SCALAR_NAME(univariate_function) fp;
+  SCALAR x0;
+  SCALAR x1;
+  SCALAR x;
+  SCALAR f0;
+  SCALAR f1;
+  bool primed;
+  double shown;
+};
+
+static inline SCALAR SCALAR_NAME(scalar_evaluate)(const SCALAR_NAME(univariate_function) f, const SCALAR x, struct SolverState* state) {
+  state->evaluations++;
+  const SCALAR fx = f(x);
+  state->value = (double) fx;
+  return fx;
+}
+
+// A STEP WITHIN SCALAR_ULPS UNITS IN THE LAST PLACE OF x CANNOT BE IMPROVED ON AND
+// COUNTS AS CONVERGED WHATEVER precision WAS ASKED FOR
+static inline double SCALAR_NAME(scalar_residual)(const SCALAR step, const SCALAR x) {
+  const SCALAR magnitude = SCALAR_FABS(x);
+  return (SCALAR_FABS(step) <= SCALAR_ULPS * SCALAR_EPSILON * (magnitude > 1 ? magnitude : 1)) ? 0 : (double) SCALAR_FABS(step);
+}
+
+static SCALAR SCALAR_NAME(run_scalar_solver)(const char* name, const solver_step step, struct SCALAR_NAME(ScalarContext)* context, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  context->shown = (double) context->x;
+  const struct Solver solver = { name, step, context, &context->shown, 1 };
+  // precision 0 (OR TOO SMALL FOR A double) FALLS BACK TO THE TYPE'S EPSILON
+  const double tolerance = (double) precision;
+  run_solver(&solver, state, max_iter, tolerance > 0 ? tolerance : (double) SCALAR_EPSILON, verbose);
+  return context->x;
+}
+
+static bool SCALAR_NAME(bisection_step)(void* ptr, struct SolverState* state) {
+  struct SCALAR_NAME(ScalarContext)* c = ptr;
+  if (!c->primed) {
+    c->f0 = SCALAR_NAME(scalar_evaluate)(c->f, c->x0, state);
+    c->f1 = SCALAR_NAME(scalar_evaluate)(c->f, c->x1, state);
+    c->primed = true;
+    if (c->f0 == 0 || c->f1 == 0) {
+      c->x = (c->f0 == 0) ? c->x0 : c->x1;
+      c->shown = (double) c->x;
+      state->residual = 0;
+      return true;
+    }
+    if (!(c->f0 * c->f1 < 0)) {
+      fprintf(stderr, "ERROR: Invalid arguments given, approximations must result in function values with opposite signs\n");
+      state->termination = SOLVER_INVALID_BRACKET;
+      return false;
+    }
+  }
+  const SCALAR x2 = (c->x0 + c->x1) / 2;
+  const SCALAR f2 = SCALAR_NAME(scalar_evaluate)(c->f, x2, state);
+  c->x = x2;
+  c->shown = (double) x2;
+  state->residual = (f2 == 0) ? 0 : SCALAR_NAME(scalar_residual)(c->x1 - c->x0, x2) / 2;
+  if (f2 * c->f0 < 0) {
+    c->x1 = c->x0;
+    c->f1 = c->f0;
+  }
+  c->x0 = x2;
+  c->f0 = f2;
+  return true;
+}
+
+SCALAR SCALAR_NAME(bisection)(const SCALAR_NAME(univariate_function) f, const SCALAR x0, const SCALAR x1, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state) {
+  struct SCALAR_NAME(ScalarContext) context = { f, NULL, x0, x1, x0, 0, 0, false, 0 };
+  return SCALAR_NAME(run_scalar_solver)("Bisection method", SCALAR_NAME(bisection_step), &context, max_iter, precision, verbose, state);
+}
+
+static bool SCALAR_NAME(newton_step)(void* ptr, struct SolverState* state) {
+  struct SCALAR_NAME(ScalarContext)* c = ptr;
+  const SCALAR x0 = c->x;
+  c->x = x0 - SCALAR_NAME(scalar_evaluate)(c->f, x0, state) / c->fp(x0);
+  c->shown = (double) c->x;
+  state->residual = SCALAR_NAME(scalar_residual)(x0 - c->x, c->x);
+  return true;
+}
+
+SCALAR SCALAR_NAME(newton)(const SCALAR_NAME(univariate_function) f, const SCALAR_NAME(univariate_function) fp, const SCALAR x0, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state) {
+  struct SCALAR_NAME(ScalarContext) context = { f, fp, 0, 0, x0, 0, 0, false, 0 };
+  return SCALAR_NAME(run_scalar_solver)("Newton's method", SCALAR_NAME(newton_step), &context, max_iter, precision, verbose, state);
+}
+
+static bool SCALAR_NAME(secant_step)(void* ptr, struct SolverState* state) {
+  struct SCALAR_NAME(ScalarContext)* c = ptr;
+  if (!c->primed) {
+    c->f0 = SCALAR_NAME(scalar_evaluate)(c->f, c->x0, state);
+    c->f1 = SCALAR_NAME(scalar_evaluate)(c->f, c->x1, state);
+    c->primed = true;
+  }
+  const SCALAR x0 = c->x0, x1 = c->x1;
+  // BOTH POINTS ON THE ROOT: THE SECANT IS UNDEFINED BUT THERE IS NOTHING LEFT TO DO
+  if (c->f1 == 0) {
+    state->residual = 0;
+    return true;
+  }
+  const SCALAR x2 = (x0 * c->f1 - x1 * c->f0) / (c->f1 - c->f0);
+  state->residual = SCALAR_NAME(scalar_residual)(x2 - x1, x2);
+  c->x0 = x1;
+  c->f0 = c->f1;
+  c->x1 = x2;
+  c->f1 = SCALAR_NAME(scalar_evaluate)(c->f, x2, state);
+  c->x = x2;
+  c->shown = (double) x2;
+  return true;
+}
+
+SCALAR SCALAR_NAME(secant)(const SCALAR_NAME(univariate_function) f, const SCALAR x1, const SCALAR x0, const unsigned int max_iter, const SCALAR precision, const bool verbose, struct SolverState* state) {
+  struct SCALAR_NAME(ScalarContext) context = { f, NULL, x0, x1, x1, 0, 0, false, 0 };
+  return SCALAR_NAME(run_scalar_solver)("Secant method", SCALAR_NAME(secant_step), &context, max_iter, precision, verbose, state);
+}
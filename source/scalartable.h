@@ -0,0 +1,56 @@
+//
+//  scalartable.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+//  Difference tables for one scalar type, included with SCALAR and SCALAR_NAME defined:
+//  by definitions.c for double and through scalarkernels.h for the other types. No include
+//  guard on purpose.
+//
+
+#ifndef scalartable_helpers
+#define scalartable_helpers
+// ORDER degree STARTS AFTER THE npoints - 1 + ... + npoints - degree + 1 ENTRIES BEFORE IT
+static inline size_t difference_offset(const unsigned long npoints, const unsigned int degree) {
+  return (size_t) (degree - 1) * npoints - (size_t) (degree - 1) * degree / 2;
+}
+#endif
+
+struct SCALAR_NAME(DifferenceTable)* SCALAR_NAME(new_difference_table_degree)(const SCALAR* val, const unsigned int npoints, const unsigned int degree) {
+  struct SCALAR_NAME(DifferenceTable)* newTable = malloc(sizeof(struct SCALAR_NAME(DifferenceTable)));
+  const unsigned int maxDegree = (npoints > 0 && degree > npoints - 1) ? npoints - 1 : (npoints > 0 ? degree : 0);
+  newTable->npoints = npoints;
+  newTable->degree = maxDegree;
+  newTable->table = malloc((difference_offset(npoints, maxDegree + 1) + 1) * sizeof(SCALAR));
+  if (maxDegree == 0)
+    return newTable;
+  // EACH ORDER IS BUILT FROM THE ONE BEFORE IT, SO THE WHOLE TABLE COSTS O(npoints * degree)
+  SCALAR* current = newTable->table;
+  for (unsigned int i = 0; i < npoints - 1; i++)
+    current[i] = val[i + 1] - val[i];
+  for (unsigned int k = 2; k <= maxDegree; k++) {
+    const SCALAR* previous = current;
+    current += npoints - k + 1;
+    for (unsigned int i = 0; i < npoints - k; i++)
+      current[i] = previous[i + 1] - previous[i];
+  }
+  return newTable;
+}
+
+void SCALAR_NAME(destroy_difference_table)(struct SCALAR_NAME(DifferenceTable)* table) {
+  if (!table)
+    return;
+  free(table->table);
+  free(table);
+}
+
+SCALAR SCALAR_NAME(difference)(const struct SCALAR_NAME(DifferenceTable)* table, const unsigned int index, const unsigned int degree) {
+  // table->degree < npoints, SO npoints - 1 - degree CANNOT WRAP (UNLIKE index + degree)
+  if (degree < 1 || degree > table->degree || index > table->npoints - 1 - degree) {
+    fprintf(stderr, "ERROR: Difference outside of table range\n");
+    exit(1);
+  }
+  return (table->table)[difference_offset(table->npoints, degree) + index];
+}
@@ -0,0 +1,204 @@
+//
+//  solver.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <fenv.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "solver.h"
+#include "definitions.h"
+
+void init_solver_state(struct SolverState* state) {
+  state->iterations = 0;
+  state->evaluations = 0;
+  state->residual = INFINITY;
+  state->value = NAN;
+  state->termination = SOLVER_RUNNING;
+}
+
+static void print_values(const double* x, const unsigned int dimension, const double precision) {
+  if (dimension == 1)
+    printf("%.*f\n", (int) -floor(log10(precision)), x[0]);
+  else
+    print_vector(x, dimension, precision);
+}
+
+static void print_iterate(const struct Solver* solver, const double precision) {
+  print_values(solver->x, solver->dimension, precision);
+}
+
+struct SolverTraceRing {
+  struct SolverTraceRecord* records;
+  unsigned long mask;
+  atomic_ulong head;
+  atomic_ulong tail;
+  atomic_ulong dropped;
+};
+
+struct SolverTraceRing* new_solver_trace_ring(const unsigned long capacity) {
+  unsigned long size = 1;
+  while (size < capacity)
+    size <<= 1;
+  struct SolverTraceRing* ring = malloc(sizeof(struct SolverTraceRing));
+  ring->records = malloc(size * sizeof(struct SolverTraceRecord));
+  ring->mask = size - 1;
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->tail, 0);
+  atomic_init(&ring->dropped, 0);
+  return ring;
+}
+
+void destroy_solver_trace_ring(struct SolverTraceRing* ring) {
+  if (!ring)
+    return;
+  free(ring->records);
+  free(ring);
+}
+
+bool solver_trace_ring_push(struct SolverTraceRing* ring, const struct SolverTraceRecord* record) {
+  const unsigned long head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) > ring->mask) {
+    atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+    return false;
+  }
+  ring->records[head & ring->mask] = *record;
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  return true;
+}
+
+bool solver_trace_ring_pop(struct SolverTraceRing* ring, struct SolverTraceRecord* record) {
+  const unsigned long tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  if (tail == atomic_load_explicit(&ring->head, memory_order_acquire))
+    return false;
+  *record = ring->records[tail & ring->mask];
+  atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+unsigned long solver_trace_ring_dropped(struct SolverTraceRing* ring) {
+  return atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+}
+
+static _Thread_local const struct SolverTrace* attachedTrace = NULL;
+
+const struct SolverTrace* solver_trace_attach(const struct SolverTrace* trace) {
+  const struct SolverTrace* previous = attachedTrace;
+  attachedTrace = trace;
+  return previous;
+}
+
+void solver_trace_print(const struct SolverTraceRecord* record, const double* x, const unsigned int dimension, void* data) {
+  printf("Iteration #%i\t : ", record->iteration);
+  print_values(x, dimension, *(const double*) data);
+}
+
+#if SOLVER_TRACING
+static void trace_iteration(const struct Solver* solver, const struct SolverState* state, const double* previous, const struct SolverTrace* trace, const bool print, const double precision) {
+  const double* x = solver->x;
+  const unsigned int dimension = solver->dimension;
+  struct SolverTraceRecord record = { state->iterations, x[0], state->value, fabs(x[0] - previous[0]), state->residual };
+  if (dimension > 1) {
+    record.x = sqrt(inner_product(x, x, dimension));
+    record.step = difference_norm(x, previous, dimension);
+  }
+  if (trace) {
+    if (trace->ring)
+      solver_trace_ring_push(trace->ring, &record);
+    if (trace->callback)
+      trace->callback(&record, x, dimension, trace->data);
+  }
+  if (print)
+    solver_trace_print(&record, x, dimension, (void*) &precision);
+}
+#endif
+
+static bool check_floating_point(struct SolverState* state) {
+  if (fetestexcept(FE_INVALID)) {
+    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
+    state->termination = SOLVER_INVALID_ARGUMENT;
+    return false;
+  }
+  // UNDERFLOW ONLY MEANS SOME RESULT WAS ROUNDED TO A SUBNORMAL OR ZERO, WHICH IS HARMLESS
+  // (DENSE UPDATES OF CONVERGING ITERATES PRODUCE TINY ENTRIES ALL THE TIME)
+  if (fetestexcept(FE_OVERFLOW)){
+    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
+    fprintf(stderr, "(check if process might be diverging)\n");
+    state->termination = SOLVER_OUT_OF_RANGE;
+    return false;
+  }
+  if (fetestexcept(FE_DIVBYZERO)){
+    fprintf(stderr, "ERROR: Division by zero detected\n");
+    state->termination = SOLVER_DIVISION_BY_ZERO;
+    return false;
+  }
+  return true;
+}
+
+enum SolverTermination run_solver(const struct Solver* solver, struct SolverState* state, const unsigned int max_iter, const double precision, const bool verbose) {
+  feclearexcept(FE_ALL_EXCEPT);
+  state->termination = SOLVER_RUNNING;
+#if SOLVER_TRACING
+  const struct SolverTrace* trace = attachedTrace;
+  bool tracing = verbose || trace;
+  // THE PREVIOUS ITERATE IS AS LARGE AS THE SYSTEM, SO IT GOES ON THE HEAP (ONCE PER SOLVE)
+  // UNLESS IT IS A SINGLE VALUE
+  double single;
+  double* previous = &single;
+  if (tracing && solver->dimension > 1) {
+    previous = malloc(solver->dimension * sizeof(double));
+    if (!previous) {
+      fprintf(stderr, "ERROR: Not enough memory to trace %s, continuing without tracing\n", solver->name);
+      tracing = false;
+    }
+  }
+#endif
+  while (true) {
+    if (max_iter && state->iterations >= max_iter) {
+      fprintf(stderr, "%s wasn't able to converge in %i iterations.\n", solver->name, max_iter);
+      if (verbose) {
+        printf("Last value : ");
+        print_iterate(solver, precision);
+      }
+      state->termination = SOLVER_MAX_ITERATIONS;
+      break;
+    }
+    if (!check_floating_point(state))
+      break;
+#if SOLVER_TRACING
+    if (tracing)
+      memcpy(previous, solver->x, solver->dimension * sizeof(double));
+#endif
+    if (!solver->step(solver->context, state)) {
+      if (state->termination == SOLVER_RUNNING)
+        state->termination = SOLVER_INVALID_ARGUMENT;
+      break;
+    }
+    state->iterations++;
+#if SOLVER_TRACING
+    if (tracing)
+      trace_iteration(solver, state, previous, trace, verbose && !(state->residual < precision), precision);
+#endif
+    if (state->residual < precision) {
+      if (verbose) {
+        printf("%s converged to ", solver->name);
+        print_iterate(solver, precision);
+      }
+      state->termination = SOLVER_CONVERGED;
+      break;
+    }
+  }
+#if SOLVER_TRACING
+  if (previous != &single)
+    free(previous);
+#endif
+  return state->termination;
+}
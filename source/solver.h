@@ -0,0 +1,116 @@
+//
+//  solver.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef solver_h
+#define solver_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// ITERATION TRACING: BUILD WITH -DSOLVER_TRACING=0 TO COMPILE IT OUT OF run_solver ENTIRELY
+// (INCLUDING THE PER-ITERATION LINES OF verbose OUTPUT)
+#ifndef SOLVER_TRACING
+#define SOLVER_TRACING 1
+#endif
+
+// REASON AN ITERATIVE SOLVE STOPPED
+enum SolverTermination {
+  SOLVER_RUNNING,
+  SOLVER_CONVERGED,
+  SOLVER_MAX_ITERATIONS,
+  SOLVER_INVALID_ARGUMENT,
+  SOLVER_OUT_OF_RANGE,
+  SOLVER_DIVISION_BY_ZERO,
+  SOLVER_INVALID_BRACKET,
+  SOLVER_SINGULAR_JACOBIAN
+};
+
+// CALLER-OWNED STATE OF A SINGLE SOLVE, SO SOLVERS KEEP NO STATE OF THEIR OWN
+// value IS THE LAST FUNCTION VALUE SAMPLED (||F|| FOR SYSTEMS THAT COMPUTE IT), NAN OTHERWISE
+struct SolverState {
+  unsigned int iterations;
+  unsigned long evaluations;
+  double residual;
+  double value;
+  enum SolverTermination termination;
+};
+
+// ONE STEP OF AN ITERATIVE METHOD: ADVANCES THE ITERATE KEPT IN context AND STORES
+// THE NEW RESIDUAL IN state. RETURNS false (WITH state->termination SET) IF THE STEP
+// COULD NOT BE TAKEN
+typedef bool (*solver_step)(void* context, struct SolverState* state);
+
+struct Solver {
+  const char* name;
+  solver_step step;
+  void* context;
+  const double* x;
+  unsigned int dimension;
+};
+
+void init_solver_state(struct SolverState* state);
+
+// ONE ITERATION AS SEEN BY A TRACE CONSUMER. FOR SYSTEMS x AND step ARE EUCLIDEAN NORMS
+struct SolverTraceRecord {
+  unsigned int iteration;
+  double x;
+  double fx;
+  double step;
+  double residual;
+};
+
+// x IS THE FULL ITERATE AFTER THE STEP
+typedef void (*solver_trace_callback)(const struct SolverTraceRecord* record, const double* x, const unsigned int dimension, void* data);
+
+// FIXED-SIZE LOCK-FREE RING OF TRACE RECORDS FOR ONE PRODUCER (THE SOLVING THREAD) AND ONE
+// CONSUMER. WHEN FULL, NEW RECORDS ARE DROPPED AND COUNTED RATHER THAN BLOCKING THE SOLVER
+struct SolverTraceRing;
+
+// capacity IS ROUNDED UP TO A POWER OF TWO
+struct SolverTraceRing* new_solver_trace_ring(const unsigned long capacity);
+
+void destroy_solver_trace_ring(struct SolverTraceRing* ring);
+
+bool solver_trace_ring_push(struct SolverTraceRing* ring, const struct SolverTraceRecord* record);
+
+// RETURNS false IF THE RING IS EMPTY
+bool solver_trace_ring_pop(struct SolverTraceRing* ring, struct SolverTraceRecord* record);
+
+unsigned long solver_trace_ring_dropped(struct SolverTraceRing* ring);
+
+// CONSUMERS OF A TRACE: EITHER OR BOTH MAY BE NULL
+struct SolverTrace {
+  solver_trace_callback callback;
+  void* data;
+  struct SolverTraceRing* ring;
+};
+
+// ATTACHES trace TO EVERY SOLVE RUN ON THE CALLING THREAD UNTIL IT IS REPLACED (NULL DETACHES)
+// RETURNS THE PREVIOUSLY ATTACHED TRACE SO CALLS CAN BE NESTED
+const struct SolverTrace* solver_trace_attach(const struct SolverTrace* trace);
+
+// THE TEXT OUTPUT OF verbose AS A TRACE CONSUMER. data POINTS TO THE PRECISION (A double)
+// USED TO CHOOSE THE NUMBER OF PRINTED DIGITS
+void solver_trace_print(const struct SolverTraceRecord* record, const double* x, const unsigned int dimension, void* data);
+
+// LOOP-BASED ENGINE SHARED BY EVERY ITERATIVE METHOD
+// STOPS ONCE state->residual < precision OR AFTER max_iter STEPS (0 MEANS NO LIMIT)
+enum SolverTermination run_solver(const struct Solver* solver, struct SolverState* state, const unsigned int max_iter, const double precision, const bool verbose);
+
+static inline double solver_evaluate(const univariate_function f, const double x, struct SolverState* state) {
+  state->evaluations++;
+  return state->value = f(x);
+}
+
+static inline void solver_evaluate_multi(const multivariate_function f, const double* x, double* fx, struct SolverState* state) {
+  state->evaluations++;
+  f(x, fx);
+}
+
+#endif /* solver_h */
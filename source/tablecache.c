@@ -0,0 +1,198 @@
+//
+//  tablecache.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "tablecache.h"
+#include "definitions.h"
+
+// THE TABLE COMES FIRST, SO THE POINTER HANDED OUT ALSO ADDRESSES ITS ENTRY
+struct CacheEntry {
+  struct DifferenceTable table;
+  const double* data;
+  double* copy;
+  size_t bytes;
+  unsigned int references;
+  bool cached;
+  struct CacheEntry* previous;
+  struct CacheEntry* next;
+};
+
+static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+// MOST RECENTLY USED FIRST
+static struct CacheEntry* cacheHead = NULL;
+static struct CacheEntry* cacheTail = NULL;
+static size_t cacheBudget = DIFFERENCE_TABLE_CACHE_BUDGET;
+static unsigned int cacheDegree = DIFFERENCE_TABLE_CACHE_DEGREE;
+static struct DifferenceTableCacheStats cacheStats;
+
+static void unlink_entry(struct CacheEntry* entry) {
+  if (entry->previous)
+    entry->previous->next = entry->next;
+  else
+    cacheHead = entry->next;
+  if (entry->next)
+    entry->next->previous = entry->previous;
+  else
+    cacheTail = entry->previous;
+  entry->previous = entry->next = NULL;
+}
+
+static void push_front(struct CacheEntry* entry) {
+  entry->previous = NULL;
+  entry->next = cacheHead;
+  if (cacheHead)
+    cacheHead->previous = entry;
+  cacheHead = entry;
+  if (!cacheTail)
+    cacheTail = entry;
+}
+
+static void free_entry(struct CacheEntry* entry) {
+  free(entry->table.table);
+  free(entry->copy);
+  free(entry);
+}
+
+// TAKES entry OUT OF THE CACHE; IT IS FREED NOW OR BY ITS LAST release_difference_table
+static void evict(struct CacheEntry* entry) {
+  unlink_entry(entry);
+  entry->cached = false;
+  cacheStats.entries--;
+  cacheStats.bytes -= entry->bytes;
+  cacheStats.evictions++;
+  if (!entry->references)
+    free_entry(entry);
+}
+
+static void enforce_budget(void) {
+  while (cacheTail && cacheStats.bytes > cacheBudget)
+    evict(cacheTail);
+}
+
+static struct CacheEntry* find(const double* fval, const unsigned int npoints) {
+  for (struct CacheEntry* entry = cacheHead; entry; entry = entry->next) {
+    if (entry->data == fval && entry->table.npoints == npoints)
+      return entry;
+  }
+  return NULL;
+}
+
+// THE COPY IS NEVER WRITTEN AFTER THE ENTRY IS BUILT, SO A CALLER HOLDING A REFERENCE MAY
+// COMPARE AGAINST IT WITHOUT THE LOCK
+static bool matches(const struct CacheEntry* entry, const double* fval) {
+  return !memcmp(entry->copy, fval, entry->table.npoints * sizeof(double));
+}
+
+const struct DifferenceTable* acquire_difference_table(const double* fval, const unsigned int npoints, const unsigned int degree) {
+  const unsigned int wanted = (npoints && degree > npoints - 1) ? npoints - 1 : degree;
+  pthread_mutex_lock(&cacheLock);
+  struct CacheEntry* entry = find(fval, npoints);
+  if (entry && entry->table.degree >= wanted) {
+    unlink_entry(entry);
+    push_front(entry);
+    entry->references++;
+    pthread_mutex_unlock(&cacheLock);
+    const bool hit = matches(entry, fval);
+    pthread_mutex_lock(&cacheLock);
+    if (hit) {
+      cacheStats.hits++;
+      pthread_mutex_unlock(&cacheLock);
+      return &entry->table;
+    }
+    // fval CHANGED SINCE THE TABLE WAS BUILT
+    entry->references--;
+    if (entry->cached)
+      evict(entry);
+    else if (!entry->references)
+      free_entry(entry);
+  } else if (entry) {
+    // A TABLE OF TOO LOW A DEGREE IS REPLACED BY A DEEPER ONE
+    evict(entry);
+  }
+  cacheStats.misses++;
+  const unsigned int buildDegree = (cacheDegree > wanted) ? cacheDegree : wanted;
+  pthread_mutex_unlock(&cacheLock);
+
+  // BUILT OUTSIDE THE LOCK, SO OTHER THREADS KEEP HITTING THE CACHE MEANWHILE
+  struct DifferenceTable* built = new_difference_table_degree(fval, npoints, buildDegree);
+  entry = malloc(sizeof(struct CacheEntry));
+  entry->table = *built;
+  free(built);
+  const size_t d = entry->table.degree;
+  entry->data = fval;
+  entry->copy = malloc(npoints * sizeof(double));
+  memcpy(entry->copy, fval, npoints * sizeof(double));
+  entry->bytes = sizeof(struct CacheEntry) + (d * npoints - d * (d + 1) / 2 + 1 + npoints) * sizeof(double);
+  entry->references = 1;
+  entry->cached = true;
+
+  pthread_mutex_lock(&cacheLock);
+  // ANOTHER THREAD MAY HAVE CACHED THE SAME TABLE WHILE THIS ONE WAS BUILDING
+  struct CacheEntry* raced = find(fval, npoints);
+  if (raced && raced->table.degree >= entry->table.degree && !memcmp(raced->copy, entry->copy, npoints * sizeof(double))) {
+    free_entry(entry);
+    unlink_entry(raced);
+    push_front(raced);
+    raced->references++;
+    pthread_mutex_unlock(&cacheLock);
+    return &raced->table;
+  }
+  if (raced)
+    evict(raced);
+  push_front(entry);
+  cacheStats.entries++;
+  cacheStats.bytes += entry->bytes;
+  enforce_budget();
+  pthread_mutex_unlock(&cacheLock);
+  return &entry->table;
+}
+
+void release_difference_table(const struct DifferenceTable* table) {
+  if (!table)
+    return;
+  struct CacheEntry* entry = (struct CacheEntry*) table;
+  pthread_mutex_lock(&cacheLock);
+  if (!--entry->references && !entry->cached)
+    free_entry(entry);
+  pthread_mutex_unlock(&cacheLock);
+}
+
+void set_difference_table_cache_budget(const size_t bytes) {
+  pthread_mutex_lock(&cacheLock);
+  cacheBudget = bytes;
+  enforce_budget();
+  pthread_mutex_unlock(&cacheLock);
+}
+
+void set_difference_table_cache_degree(const unsigned int degree) {
+  pthread_mutex_lock(&cacheLock);
+  cacheDegree = degree;
+  pthread_mutex_unlock(&cacheLock);
+}
+
+void invalidate_difference_table_cache(const double* fval) {
+  pthread_mutex_lock(&cacheLock);
+  for (struct CacheEntry* entry = cacheHead; entry;) {
+    struct CacheEntry* next = entry->next;
+    if (!fval || entry->data == fval)
+      evict(entry);
+    entry = next;
+  }
+  pthread_mutex_unlock(&cacheLock);
+}
+
+void get_difference_table_cache_stats(struct DifferenceTableCacheStats* stats) {
+  pthread_mutex_lock(&cacheLock);
+  *stats = cacheStats;
+  pthread_mutex_unlock(&cacheLock);
+}
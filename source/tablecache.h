@@ -0,0 +1,54 @@
+//
+//  tablecache.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef tablecache_h
+#define tablecache_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// PROCESS-WIDE, THREAD-SAFE LRU CACHE OF DIFFERENCE TABLES, USED BY THE *2 INTERPOLATION
+// ENTRY POINTS SO REPEATED CALLS ON THE SAME fval ONLY PAY FOR THE EVALUATION
+//
+// A TABLE IS KEYED BY THE ADDRESS OF fval AND npoints, AND KEEPS A COPY OF THE DATA IT WAS
+// BUILT FROM. A LOOKUP COMPARES fval WITH THAT COPY, SO A BUFFER CHANGED IN ANY WAY SINCE IS
+// REBUILT AND RESULTS ARE ALWAYS THOSE OF A FRESH TABLE. THE COMPARISON COSTS O(npoints),
+// AGAINST O(npoints * degree) FOR BUILDING THE TABLE
+//
+// TABLES ARE BUILT UP TO THE CACHE DEGREE (OR THE REQUESTED ONE IF HIGHER), SO CALLS WITH
+// DIFFERENT DEGREES SHARE A TABLE. LEAST RECENTLY USED TABLES ARE EVICTED ONCE THE BUDGET
+// IS EXCEEDED; A TABLE STILL HELD BY A CALLER IS FREED WHEN IT IS RELEASED
+#define DIFFERENCE_TABLE_CACHE_BUDGET ((size_t) 64 << 20)
+#define DIFFERENCE_TABLE_CACHE_DEGREE 8
+
+struct DifferenceTableCacheStats {
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+  unsigned int entries;
+  size_t bytes;
+};
+
+// RETURNS A TABLE OF fval OF AT LEAST THE GIVEN DEGREE (CAPPED AT npoints - 1). IT STAYS
+// VALID UNTIL PASSED TO release_difference_table
+const struct DifferenceTable* acquire_difference_table(const double* fval, const unsigned int npoints, const unsigned int degree);
+
+void release_difference_table(const struct DifferenceTable* table);
+
+// A BUDGET OF 0 DISABLES CACHING: EVERY TABLE IS FREED ON RELEASE
+void set_difference_table_cache_budget(const size_t bytes);
+
+void set_difference_table_cache_degree(const unsigned int degree);
+
+// DROPS EVERY TABLE BUILT FROM fval (OR EVERY TABLE WHEN fval IS NULL), E.G. TO FREE MEMORY
+void invalidate_difference_table_cache(const double* fval);
+
+void get_difference_table_cache_stats(struct DifferenceTableCacheStats* stats);
+
+#endif /* tablecache_h */
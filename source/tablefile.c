@@ -0,0 +1,147 @@
+//
+//  tablefile.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/13/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tablefile.h"
+#include "definitions.h"
+
+static uint64_t align_up(const uint64_t offset, const uint64_t alignment) {
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+static bool write_section(FILE* file, uint64_t* position, const uint64_t offset, const double* data, const size_t count) {
+  static const char zeros[64] = { 0 };
+  while (*position < offset) {
+    const size_t pad = (offset - *position < sizeof(zeros)) ? (size_t) (offset - *position) : sizeof(zeros);
+    if (fwrite(zeros, 1, pad, file) != pad)
+      return false;
+    *position += pad;
+  }
+  if (fwrite(data, sizeof(double), count, file) != count)
+    return false;
+  *position += count * sizeof(double);
+  return true;
+}
+
+bool write_table_file(const char* path, const double* xval, const double* fval, const unsigned long npoints, const unsigned int degree, const unsigned int alignment) {
+  struct TableFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, TABLE_FILE_MAGIC, sizeof(header.magic));
+  uint64_t align = sizeof(double);
+  while (align < alignment)
+    align *= 2;
+  header.alignment = (uint32_t) align;
+  header.npoints = npoints;
+  header.x0 = npoints ? xval[0] : 0;
+  header.h_width = (npoints > 1) ? (xval[npoints - 1] - xval[0]) / (npoints - 1) : 0;
+  header.flags = TABLE_FILE_UNIFORM;
+  for (unsigned long i = 0; i < npoints; i++) {
+    const double expected = header.x0 + i * header.h_width;
+    if (fabs(xval[i] - expected) > 8 * DBL_EPSILON * fmax(fabs(xval[i]), fabs(header.h_width) * npoints)) {
+      header.flags &= ~TABLE_FILE_UNIFORM;
+      break;
+    }
+  }
+  struct DifferenceTable* differences = degree ? new_difference_table_degree(fval, (unsigned int) npoints, degree) : NULL;
+  header.differenceDegree = differences ? differences->degree : 0;
+  const size_t ndifferences = header.differenceDegree ? (size_t) header.differenceDegree * npoints - (size_t) header.differenceDegree * (header.differenceDegree + 1) / 2 : 0;
+  header.xvalOffset = align_up(sizeof(header), align);
+  header.fvalOffset = align_up(header.xvalOffset + npoints * sizeof(double), align);
+  header.differenceOffset = ndifferences ? align_up(header.fvalOffset + npoints * sizeof(double), align) : 0;
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    fprintf(stderr, "ERROR: Unable to open %s for writing\n", path);
+    destroy_difference_table(differences);
+    return false;
+  }
+  uint64_t position = sizeof(header);
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  ok = ok && write_section(file, &position, header.xvalOffset, xval, npoints);
+  ok = ok && write_section(file, &position, header.fvalOffset, fval, npoints);
+  if (ndifferences)
+    ok = ok && write_section(file, &position, header.differenceOffset, differences->table, ndifferences);
+  ok = (fclose(file) == 0) && ok;
+  destroy_difference_table(differences);
+  if (!ok)
+    fprintf(stderr, "ERROR: Unable to write %s\n", path);
+  return ok;
+}
+
+static bool section_fits(const uint64_t offset, const uint64_t count, const size_t length) {
+  return offset % sizeof(double) == 0 && offset <= length && count <= (length - offset) / sizeof(double);
+}
+
+struct TableFile* open_table_file(const char* path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "ERROR: Unable to open %s\n", path);
+    return NULL;
+  }
+  struct stat info;
+  if (fstat(fd, &info) || (size_t) info.st_size < sizeof(struct TableFileHeader)) {
+    fprintf(stderr, "ERROR: %s is not a table file\n", path);
+    close(fd);
+    return NULL;
+  }
+  const size_t length = (size_t) info.st_size;
+  void* mapping = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    fprintf(stderr, "ERROR: Unable to map %s\n", path);
+    return NULL;
+  }
+  const struct TableFileHeader* header = mapping;
+  const uint64_t n = header->npoints;
+  const uint64_t degree = header->differenceDegree;
+  // THE HEADER IS UNTRUSTED: degree MUST FIT THE unsigned int OF struct DifferenceTable AND
+  // degree * n MUST NOT WRAP BEFORE THE DIFFERENCE SECTION IS CHECKED AGAINST THE FILE SIZE
+  // (degree < n THEN KEEPS degree * (degree + 1) / 2 BELOW degree * n)
+  const bool degreeValid = !degree || (degree <= UINT_MAX && degree < n && degree <= UINT64_MAX / n);
+  const uint64_t ndifferences = (degree && degreeValid) ? degree * n - degree * (degree + 1) / 2 : 0;
+  if (memcmp(header->magic, TABLE_FILE_MAGIC, sizeof(header->magic)) || !degreeValid
+      || !section_fits(header->xvalOffset, n, length) || !section_fits(header->fvalOffset, n, length)
+      || (degree && !section_fits(header->differenceOffset, ndifferences, length))) {
+    fprintf(stderr, "ERROR: %s is not a valid table file\n", path);
+    munmap(mapping, length);
+    return NULL;
+  }
+  struct TableFile* table = malloc(sizeof(struct TableFile));
+  table->mapping = mapping;
+  table->length = length;
+  table->xval = (const double*) ((const char*) mapping + header->xvalOffset);
+  table->fval = (const double*) ((const char*) mapping + header->fvalOffset);
+  table->npoints = (unsigned long) n;
+  table->uniform = header->flags & TABLE_FILE_UNIFORM;
+  table->x0 = header->x0;
+  table->h_width = header->h_width;
+  // struct DifferenceTable HAS A NON-CONST table POINTER, SO ONLY A CONST VIEW OF IT IS PUBLIC
+  table->differenceView.table = degree ? (double*) ((char*) mapping + header->differenceOffset) : NULL;
+  table->differenceView.npoints = (unsigned long) n;
+  table->differenceView.degree = (unsigned int) degree;
+  table->differences = degree ? &table->differenceView : NULL;
+  return table;
+}
+
+void close_table_file(struct TableFile* table) {
+  if (!table)
+    return;
+  munmap(table->mapping, table->length);
+  free(table);
+}
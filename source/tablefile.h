@@ -0,0 +1,70 @@
+//
+//  tablefile.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/13/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef tablefile_h
+#define tablefile_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// BINARY TABLE FILE LAYOUT (HOST BYTE ORDER):
+//   struct TableFileHeader
+//   xval[npoints]                          AT xvalOffset
+//   fval[npoints]                          AT fvalOffset
+//   DIFFERENCE TABLE OF ORDERS 1..degree   AT differenceOffset (OPTIONAL, SAME LAYOUT AS
+//                                          struct DifferenceTable, ORDER BY ORDER)
+// EVERY SECTION STARTS ON A MULTIPLE OF alignment BYTES
+#define TABLE_FILE_MAGIC "NUMTAB01"
+#define TABLE_FILE_UNIFORM 1u
+
+struct TableFileHeader {
+  char magic[8];
+  uint32_t flags;
+  uint32_t alignment;
+  uint64_t npoints;
+  double x0;
+  double h_width;
+  uint32_t differenceDegree;
+  uint32_t reserved;
+  uint64_t xvalOffset;
+  uint64_t fvalOffset;
+  uint64_t differenceOffset;
+};
+
+// READ-ONLY MAPPING OF A TABLE FILE. xval, fval AND differences POINT STRAIGHT INTO THE
+// MAPPING, SO THEY CAN BE PASSED TO lagrange, aitken, newton_*, stirling AND everett
+// WITHOUT COPYING. differences IS NULL WHEN THE FILE HAS NO DIFFERENCE SECTION
+// THE MAPPING IS PROT_READ: WRITING THROUGH ANY OF THESE POINTERS (INCLUDING
+// differences->table) RAISES SIGSEGV. COPY THE DATA FIRST TO MODIFY IT
+// differenceView IS THE STORAGE BEHIND differences AND IS NOT MEANT TO BE USED DIRECTLY
+struct TableFile {
+  void* mapping;
+  size_t length;
+  const double* xval;
+  const double* fval;
+  unsigned long npoints;
+  bool uniform;
+  double x0;
+  double h_width;
+  const struct DifferenceTable* differences;
+  struct DifferenceTable differenceView;
+};
+
+// RETURNS NULL (AFTER REPORTING TO stderr) IF THE FILE CANNOT BE MAPPED OR IS MALFORMED
+struct TableFile* open_table_file(const char* path);
+
+void close_table_file(struct TableFile* table);
+
+// WRITES A TABLE FILE, WITH DIFFERENCES UP TO degree (0 FOR NONE). THE GRID IS MARKED
+// UNIFORM WHEN EVERY xval[i] EQUALS xval[0] + i * h TO ROUNDING. alignment IS ROUNDED UP
+// TO A POWER OF TWO OF AT LEAST sizeof(double). RETURNS false ON I/O FAILURE
+bool write_table_file(const char* path, const double* xval, const double* fval, const unsigned long npoints, const unsigned int degree, const unsigned int alignment);
+
+#endif /* tablefile_h */
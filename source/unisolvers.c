@@ -12,274 +12,312 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <float.h>
 #include "unisolvers.h"
 #include "definitions.h"
+#include "solver.h"
+#include "dual.h"
 
-// BISECTION METHOD IMPLEMENTATION
-double bisection(const univariate_function f, const double x0, const double x1, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (!(f(x0) * f(x1) < 0)) {
+// ITERATES SHARED BY THE UNIVARIATE METHODS (x0 IS THE OLDEST, x2 THE NEWEST)
+// f0, f1 AND f2 CARRY f(x0), f(x1) AND f(x2) FORWARD ONCE primed, SO EVERY POINT IS
+// EVALUATED EXACTLY ONCE
+struct UnivariateContext {
+  univariate_function f;
+  univariate_function fp;
+  double x0;
+  double x1;
+  double x2;
+  double x;
+  double precision;
+  double f0;
+  double f1;
+  double f2;
+  double step;
+  double lastStep;
+  bool primed;
+};
+
+static double run_univariate(const char* name, const solver_step step, struct UnivariateContext* context, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  const struct Solver solver = { name, step, context, &context->x, 1 };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  return context->x;
+}
+
+// PRIMES THE BRACKET [x0, x1]: RETURNS false ON AN INVALID BRACKET, OR SETS c->x AND A ZERO
+// RESIDUAL WHEN AN ENDPOINT IS ALREADY A ROOT
+static bool prime_bracket(struct UnivariateContext* c, struct SolverState* state) {
+  c->f0 = solver_evaluate(c->f, c->x0, state);
+  c->f1 = solver_evaluate(c->f, c->x1, state);
+  c->primed = true;
+  if (c->f0 == 0 || c->f1 == 0) {
+    c->x = (c->f0 == 0) ? c->x0 : c->x1;
+    state->residual = 0;
+    return true;
+  }
+  if (!(c->f0 * c->f1 < 0)) {
     fprintf(stderr, "ERROR: Invalid arguments given, approximations must result in function values with opposite signs\n");
-    exit(1);  
-  }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Bisection method was unable to converge in %i iterations\n", max_iter);
-    printf("Last value: %.*f\n", (int) -floor(log10(precision)), x0); 
-    return x0;
-  }
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
+    state->termination = SOLVER_INVALID_BRACKET;
+    return false;
   }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  const double x2 = (x0 + x1) / 2;
-  if (fabs(x0 - x2) < precision || fabs(x1 - x2) < precision) {
-    if (verbose)
-      printf("Bisection method converged to %.*f\n", (int) -floor(log10(precision)), x2);
-    return x2;
-  }
-  if (verbose)
-    fprintf(stdout, "Iteration #%i : %.*f\n", count, (int) -floor(log10(precision)), x2);
-  count++;
-  if (f(x2) * f(x0) < 0)
-    return bisection(f, x2, x0, max_iter, precision, verbose);
-  else
-    return bisection(f, x2, x1, max_iter, precision, verbose);
+  state->residual = fabs(c->x1 - c->x0);
+  return true;
 }
 
+// BISECTION, NEWTON'S AND SECANT METHODS COME FROM THE TEMPLATE SHARED WITH THE OTHER SCALAR
+// TYPES (scalar.h). A STEP WITHIN A FEW UNITS IN THE LAST PLACE COUNTS AS CONVERGED, AND
+// precision 0 STANDS FOR DBL_EPSILON
+#define SCALAR double
+#define SCALAR_NAME(name) name
+#define SCALAR_EPSILON DBL_EPSILON
+#define SCALAR_FABS fabs
+#include "scalarsolvers.h"
+#undef SCALAR
+#undef SCALAR_NAME
+#undef SCALAR_EPSILON
+#undef SCALAR_FABS
+
 // UNIVARIATE LINEAR ITERATION IMPLEMENTATION
-double linear_iteration(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Linear iteration was unable to converge in %i iterations\n", max_iter);
-    printf("Last value: %.*f\n", (int) -floor(log10(precision)), x0);
-    return x0;
-  }
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  const double x1 = f(x0);
-  if (fabs(x0 - x1) < precision) {
-    if (verbose)
-      printf("Linear iteration converged to %.*f\n", (int) -floor(log10(precision)), x1);
-    return x1;
-  }
-  if (verbose)
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x1);
-  count++;
-  return linear_iteration(f, x1, max_iter, precision, verbose);
+static bool linear_iteration_step(void* ptr, struct SolverState* state) {
+  struct UnivariateContext* c = ptr;
+  const double x1 = solver_evaluate(c->f, c->x, state);
+  state->residual = fabs(c->x - x1);
+  c->x = x1;
+  return true;
 }
 
+double linear_iteration(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, 0, 0, 0, x0, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("Linear iteration", linear_iteration_step, &context, max_iter, precision, verbose, state);
+}
 
 // UNIVARIATE AITKEN'S Δ SQUARED PROCESS IMPLEMENTATION
-double aitkens_delta(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
+static bool aitkens_delta_step(void* ptr, struct SolverState* state) {
+  struct UnivariateContext* c = ptr;
+  const double x0 = c->x;
+  const double x1 = solver_evaluate(c->f, x0, state);
+  if (fabs(x0 - x1) < c->precision) {
+    c->x = x1;
+    state->residual = fabs(x0 - x1);
+    return true;
+  }
+  const double x2 = solver_evaluate(c->f, x1, state);
+  if (fabs(x1 - x2) < c->precision) {
+    c->x = x2;
+    state->residual = fabs(x1 - x2);
+    return true;
   }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Aitken's Δ squared process wasn't able to converge in %i iterations.\n", count);
-    printf("Last value : %.*f\n", (int) -floor(log10(precision)),  x0);
-    return x0;
-  }
-  const double x1 = f(x0);
-  if (fabs(x0 - x1) < precision) {
-    if (verbose)
-      printf("Aitken's Δ squared process converged to %.*f\n", (int) -floor(log10(precision)), x1);
-    return x1;
-  }
-  if (verbose)
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x1);
-  count++;
-  const double x2 = f(x1);
-  if (fabs(x1 - x2) < precision) {
-    if (verbose)
-      printf("Aitken's Δ squared process converged to %.*f\n", (int) -floor(log10(precision)), x2);
-    return x2;
-  }
-  if (verbose)
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x2);
-  count++;
   const double xcorr = (x0 * x2 - x1 * x1) / (x0 + x2 - 2 * x1);
-  if (fabs(x2 - xcorr) < precision) {
-    if (verbose)
-      printf("Aitken's Δ squared process converged to %.*f\n", (int) -floor(log10(precision)), xcorr);
-    return xcorr;
-  }
-  if (verbose)
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), xcorr);
-  count++;
-  return aitkens_delta(f, xcorr, max_iter, precision, verbose);
+  state->residual = fabs(x2 - xcorr);
+  c->x = xcorr;
+  return true;
 }
 
-// UNIVARIATE NEWTON'S METHOD IMPLEMENTATION
-double newton(const univariate_function f, const univariate_function fp, const double x0, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Newton's method wasn't able to converge in %i iterations.\n", count);
-    printf("Last value : %.*f", (int) -floor(log10(precision)),  x0);
-    return x0;
-  }
-  const double x1 = x0 - f(x0) / fp(x0);
-  if (fabs(x0 - x1) < precision) {
-    if (verbose)
-      printf("Newton's method converged to %.*f\n", (int) -floor(log10(precision)), x1);
-    return x1;
-  }
-  if (verbose)
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x1);
-  count++;
-  return newton(f, fp, x1, max_iter, precision, verbose);
+double aitkens_delta(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, 0, 0, 0, x0, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("Aitken's Δ squared process", aitkens_delta_step, &context, max_iter, precision, verbose, state);
 }
 
-// SECANT METHOD IMPLEMENTATION
-double secant(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Secant method wasn't able to converge in %i iterations.\n", count);
-    printf("Last value : %.*f", (int) -floor(log10(precision)),  x0);
-    return x0;
-  }
-  const double x2 = (x0 * f(x1) - x1 * f(x0)) / (f(x1) - f(x0));
-  if (fabs(x0 - x1) < precision) {
-    if (verbose)
-      printf("Secant method converged to %.*f\n", (int) -floor(log10(precision)), x1);
-    return x1;
-  }
-  if (verbose) {
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x1);
-  }
-  count++;
-  return secant(f, x2, x1, max_iter, precision, verbose);
+// NEWTON'S METHOD WITH THE DERIVATIVE FROM DUAL NUMBERS
+struct DualContext {
+  dual_function f;
+  double x;
+};
+
+static bool newton_dual_step(void* ptr, struct SolverState* state) {
+  struct DualContext* c = ptr;
+  const double x0 = c->x;
+  state->evaluations++;
+  const struct Dual fx = c->f(dual_variable(x0));
+  state->value = fx.value;
+  c->x = x0 - fx.value / fx.derivative;
+  state->residual = fabs(x0 - c->x);
+  return true;
+}
+
+double newton_dual(const dual_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct SolverState localState;
+  if (!state)
+    state = &localState;
+  init_solver_state(state);
+  struct DualContext context = { f, x0 };
+  const struct Solver solver = { "Newton's method (dual numbers)", newton_dual_step, &context, &context.x, 1 };
+  run_solver(&solver, state, max_iter, precision, verbose);
+  return context.x;
 }
 
 // FALSE POSITION METHOD (REGULA FALSI) IMPLEMENTATION
-double false_position(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "False position method wasn't able to converge in %i iterations.\n", count);
-    printf("Last value : %.*f", (int) -floor(log10(precision)),  x0);
-    return x0;
-  }
-  const double x2 = (x0 * f(x1) - x1 * f(x0)) / (f(x1) - f(x0));
-  if (fabs(x2 - x1) < precision || fabs(x2 - x0) < precision) {
-    if (verbose)
-      printf("False position method converged to %.*f\n", (int) -floor(log10(precision)), x2);
-    return x2;
-  }
-  if (verbose) {
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x2);
-  }
-  count++;
-  if (f(x2) * f(x0) < 1)
-    return false_position(f, x2, x0, max_iter, precision, verbose);
-  else
-    return false_position(f, x1, x2, max_iter, precision, verbose);
+static bool false_position_step(void* ptr, struct SolverState* state) {
+  struct UnivariateContext* c = ptr;
+  if (!c->primed) {
+    c->f0 = solver_evaluate(c->f, c->x0, state);
+    c->f1 = solver_evaluate(c->f, c->x1, state);
+    c->primed = true;
+  }
+  const double x0 = c->x0, x1 = c->x1;
+  const double x2 = (x0 * c->f1 - x1 * c->f0) / (c->f1 - c->f0);
+  const double f2 = solver_evaluate(c->f, x2, state);
+  state->residual = fmin(fabs(x2 - x1), fabs(x2 - x0));
+  c->x = x2;
+  if (f2 * c->f0 < 0) {
+    c->x1 = x2;
+    c->f1 = f2;
+  } else {
+    c->x0 = x2;
+    c->f0 = f2;
+  }
+  return true;
+}
+
+double false_position(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, x0, x1, 0, x1, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("False position method", false_position_step, &context, max_iter, precision, verbose, state);
+}
+
+// MODIFIED FALSE POSITION: x1 IS THE NEWEST ENDPOINT. WHEN THE SAME ENDPOINT x0 IS RETAINED
+// TWICE IN A ROW ITS FUNCTION VALUE IS SCALED DOWN SO IT CANNOT STAY FIXED FOREVER
+static bool modified_false_position_step(struct UnivariateContext* c, struct SolverState* state, const bool andersonBjorck) {
+  if (!c->primed && (!prime_bracket(c, state) || state->residual == 0))
+    return state->termination == SOLVER_RUNNING;
+  const double x0 = c->x0, x1 = c->x1;
+  const double x2 = (x0 * c->f1 - x1 * c->f0) / (c->f1 - c->f0);
+  const double f2 = solver_evaluate(c->f, x2, state);
+  state->residual = (f2 == 0) ? 0 : fmin(fabs(x2 - x1), fabs(x2 - x0));
+  c->x = x2;
+  if (f2 * c->f1 < 0) {
+    c->x0 = x1;
+    c->f0 = c->f1;
+  } else {
+    const double m = andersonBjorck ? 1 - f2 / c->f1 : 0.5;
+    c->f0 *= (m > 0) ? m : 0.5;
+  }
+  c->x1 = x2;
+  c->f1 = f2;
+  return true;
+}
+
+static bool illinois_step(void* ptr, struct SolverState* state) {
+  return modified_false_position_step(ptr, state, false);
+}
+
+static bool anderson_bjorck_step(void* ptr, struct SolverState* state) {
+  return modified_false_position_step(ptr, state, true);
+}
+
+double illinois(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, x0, x1, 0, x1, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("Illinois method", illinois_step, &context, max_iter, precision, verbose, state);
+}
+
+double anderson_bjorck(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, x0, x1, 0, x1, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("Anderson-Björck method", anderson_bjorck_step, &context, max_iter, precision, verbose, state);
+}
+
+// BRENT'S METHOD IMPLEMENTATION
+// x1 IS THE BEST ESTIMATE, x2 THE CONTRAPOINT (f(x1) AND f(x2) HAVE OPPOSITE SIGNS) AND x0
+// THE PREVIOUS ESTIMATE. step AND lastStep ARE THE LAST TWO STEPS, USED TO FALL BACK TO
+// BISECTION WHEN INTERPOLATION IS NOT SHRINKING THE BRACKET FAST ENOUGH
+static bool brent_step(void* ptr, struct SolverState* state) {
+  struct UnivariateContext* c = ptr;
+  if (!c->primed) {
+    if (!prime_bracket(c, state) || state->residual == 0)
+      return state->termination == SOLVER_RUNNING;
+    c->x2 = c->x1;
+    c->f2 = c->f1;
+  }
+  if ((c->f1 > 0) == (c->f2 > 0)) {
+    c->x2 = c->x0;
+    c->f2 = c->f0;
+    c->step = c->lastStep = c->x1 - c->x0;
+  }
+  if (fabs(c->f2) < fabs(c->f1)) {
+    c->x0 = c->x1;
+    c->x1 = c->x2;
+    c->x2 = c->x0;
+    c->f0 = c->f1;
+    c->f1 = c->f2;
+    c->f2 = c->f0;
+  }
+  const double tolerance = 2 * DBL_EPSILON * fabs(c->x1) + c->precision / 2;
+  const double middle = (c->x2 - c->x1) / 2;
+  c->x = c->x1;
+  if (fabs(middle) <= tolerance || c->f1 == 0) {
+    state->residual = 0;
+    return true;
+  }
+  if (fabs(c->lastStep) >= tolerance && fabs(c->f0) > fabs(c->f1)) {
+    // INVERSE QUADRATIC INTERPOLATION, OR SECANT WHEN ONLY TWO DISTINCT POINTS ARE KNOWN
+    const double s = c->f1 / c->f0;
+    double p, q;
+    if (c->x0 == c->x2) {
+      p = 2 * middle * s;
+      q = 1 - s;
+    } else {
+      const double r0 = c->f0 / c->f2;
+      const double r1 = c->f1 / c->f2;
+      p = s * (2 * middle * r0 * (r0 - r1) - (c->x1 - c->x0) * (r1 - 1));
+      q = (r0 - 1) * (r1 - 1) * (s - 1);
+    }
+    if (p > 0)
+      q = -q;
+    p = fabs(p);
+    if (2 * p < fmin(3 * middle * q - fabs(tolerance * q), fabs(c->lastStep * q))) {
+      c->lastStep = c->step;
+      c->step = p / q;
+    } else {
+      c->step = c->lastStep = middle;
+    }
+  } else {
+    c->step = c->lastStep = middle;
+  }
+  c->x0 = c->x1;
+  c->f0 = c->f1;
+  c->x1 += (fabs(c->step) > tolerance) ? c->step : copysign(tolerance, middle);
+  c->f1 = solver_evaluate(c->f, c->x1, state);
+  c->x = c->x1;
+  state->residual = 2 * fabs(middle);
+  return true;
+}
+
+double brent(const univariate_function f, const double x0, const double x1, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, x0, x1, 0, x1, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("Brent's method", brent_step, &context, max_iter, precision, verbose, state);
 }
 
 // MÜLLER'S PROCESS IMPLEMENTATION
-double muller(const univariate_function f, const double x2, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose) {
-  static unsigned int count = 1;
-  if (fetestexcept(FE_INVALID)) {
-    fprintf(stderr, "ERROR: Invalid argument detected (check for complex or outside domain arguments)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_OVERFLOW) || fetestexcept(FE_UNDERFLOW)){
-    fprintf(stderr, "ERROR: Floating point operations have gone outside of representable range\n");
-    fprintf(stderr, "(check if process might be diverging)\n");
-    exit(1);
-  }
-  if (fetestexcept(FE_DIVBYZERO)){
-    fprintf(stderr, "ERROR: Division by zero detected\n");
-    exit(1);
-  }
-  if (max_iter && count > max_iter) {
-    fprintf(stderr, "Müller's process wasn't able to converge in %i iterations.\n", count);
-    printf("Last value : %.*f", (int) -floor(log10(precision)),  x0);
-    return x0;
-  }
+static bool muller_step(void* ptr, struct SolverState* state) {
+  struct UnivariateContext* c = ptr;
+  const univariate_function f = c->f;
+  if (!c->primed) {
+    c->f0 = solver_evaluate(f, c->x0, state);
+    c->f1 = solver_evaluate(f, c->x1, state);
+    c->f2 = solver_evaluate(f, c->x2, state);
+    c->primed = true;
+  }
+  const double x0 = c->x0, x1 = c->x1, x2 = c->x2;
+  const double f0 = c->f0, f1 = c->f1, f2 = c->f2;
   const double lambda0 = (x2 - x1) / (x1 - x0);
   const double delta = 1 + lambda0;
-  const double g = f(x0) * lambda0 * lambda0 - f(x1) * delta * delta + f(x2) * (lambda0 + delta);
-  const double lambda1 = (g > 0) ? (-2 * f(x2) * delta) / (g + sqrt(g * g - 4 * f(x2) * delta * lambda0 * (f(x0)  * lambda0 - f(x1) * delta + f(x2)))) : (-2 * f(x2) * delta) / (g - sqrt(g * g - 4 * f(x2) * delta * lambda0 * (f(x0)  * lambda0 - f(x1) * delta + f(x2))));
+  const double g = f0 * lambda0 * lambda0 - f1 * delta * delta + f2 * (lambda0 + delta);
+  const double root = sqrt(g * g - 4 * f2 * delta * lambda0 * (f0 * lambda0 - f1 * delta + f2));
+  const double lambda1 = (-2 * f2 * delta) / ((g > 0) ? g + root : g - root);
   const double x3 = x2 + lambda1 * (x2 - x1);
-  if (fabs(x2 - x3) < precision) {
-    if (verbose) {
-      printf("Müller's process converged to %.*f\n", (int) -floor(log10(precision)), x3);
-    }
-    return x3;
-  }
-  if (verbose) {
-    printf("Iteration #%i\t : %.*f\n", count, (int) -floor(log10(precision)), x3);
-  }
-  count++;
-  return muller(f, x3, x2, x1, max_iter, precision, verbose);
+  state->residual = fabs(x2 - x3);
+  c->x0 = x1;
+  c->x1 = x2;
+  c->x2 = x3;
+  c->f0 = f1;
+  c->f1 = f2;
+  c->f2 = solver_evaluate(f, x3, state);
+  c->x = x3;
+  return true;
 }
 
+double muller(const univariate_function f, const double x2, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state) {
+  struct UnivariateContext context = { f, NULL, x0, x1, x2, x2, precision, 0, 0, 0, 0, 0, false };
+  return run_univariate("Müller's process", muller_step, &context, max_iter, precision, verbose, state);
+}
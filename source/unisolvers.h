@@ -12,34 +12,55 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "definitions.h"
+#include "solver.h"
+#include "dual.h"
+
+// EVERY SOLVER RECORDS ITS ITERATIONS, FUNCTION EVALUATIONS, LAST RESIDUAL AND
+// TERMINATION REASON IN state, WHICH MAY BE NULL WHEN THE CALLER DOES NOT NEED THEM
+// FUNCTION VALUES ARE CARRIED BETWEEN ITERATIONS: AFTER THE STARTING POINTS ARE EVALUATED,
+// BISECTION, SECANT, FALSE POSITION (AND ITS MODIFICATIONS), BRENT AND MÜLLER COST ONE CALL TO f PER ITERATION
 
 // IMPLEMENTATIONS OF THE BISECTION METHOD
 // CONVERGENCE: LINEAR (GUARANTEED)
-double bisection(const univariate_function f, const double x0, const double x1, const unsigned int max_iter, const double precision, const bool verbose);
+double bisection(const univariate_function f, const double x0, const double x1, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATIONS OF UNIVARIATE LINEAR ITERATION
 // CONVERGENCE: LINEAR
-double linear_iteration(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose);
+double linear_iteration(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATIONS OF UNIVARIATE AITKEN'S Δ SQUARED PROCESS
 // CONVERGENCE: LINEAR BUT ALWAYS BETTER THAN LINEAR ITERATION
-double aitkens_delta(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose);
+double aitkens_delta(const univariate_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATIONS OF UNIVARIATE NEWTON'S METHOD
 // CONVERGENCE: QUADRATIC
-double newton(const univariate_function f, const univariate_function fp, const double x0, const unsigned int max_iter, const double precision, const bool verbose);
+double newton(const univariate_function f, const univariate_function fp, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// NEWTON'S METHOD WITH f WRITTEN AGAINST struct Dual: ONE CALL GIVES f(x) AND f'(x) EXACTLY
+// CONVERGENCE: QUADRATIC
+double newton_dual(const dual_function f, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATIONS OF SECANT METHOD
 // CONVERGENCE: SUPERLINEAR BUT NOT QUADRATIC
-double secant(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose);
+double secant(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATION OF FALSE POSITION METHOD
 // CONVERGENCE: SUPERLINEAR BUT NOT QUADRATIC (GUARANTEED)
 
-double false_position(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose);
+double false_position(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// IMPLEMENTATIONS OF THE ILLINOIS AND ANDERSON-BJÖRCK MODIFICATIONS OF FALSE POSITION
+// CONVERGENCE: SUPERLINEAR, ORDER 1.44 AND ABOUT 1.7 RESPECTIVELY (GUARANTEED)
+double illinois(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+double anderson_bjorck(const univariate_function f, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
+
+// IMPLEMENTATION OF BRENT'S METHOD (INVERSE QUADRATIC INTERPOLATION, SECANT AND BISECTION)
+// CONVERGENCE: SUPERLINEAR, NEVER MUCH SLOWER THAN BISECTION (GUARANTEED)
+double brent(const univariate_function f, const double x0, const double x1, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 // IMPLEMENTATION OF MÜLLER'S METHOD
-double muller(const univariate_function f, const double x2, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose);
+double muller(const univariate_function f, const double x2, const double x1, const double x0, const unsigned int max_iter, const double precision, const bool verbose, struct SolverState* state);
 
 
 #endif /* unisolvers_h */
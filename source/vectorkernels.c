@@ -0,0 +1,345 @@
+//
+//  vectorkernels.c
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "vectorkernels.h"
+#include "definitions.h"
+#include "matrixkernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_X86 1
+#include <immintrin.h>
+#else
+#define VECTOR_X86 0
+#endif
+
+// difference_norm_bounded CHECKS ITS PARTIAL SUM AFTER EVERY CHUNK OF THIS MANY ELEMENTS
+#define VECTOR_EARLY_EXIT_CHUNK 1024
+
+typedef double (*vector_kernel)(const double* v1, const double* v2, const size_t n);
+
+// PORTABLE VARIANTS: FOUR ACCUMULATORS HIDE THE LATENCY OF THE FLOATING-POINT ADD
+
+static double dot_generic(const double* v1, const double* v2, const size_t n) {
+  double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    s0 += v1[i] * v2[i];
+    s1 += v1[i + 1] * v2[i + 1];
+    s2 += v1[i + 2] * v2[i + 2];
+    s3 += v1[i + 3] * v2[i + 3];
+  }
+  for (; i < n; i++)
+    s0 += v1[i] * v2[i];
+  return (s0 + s1) + (s2 + s3);
+}
+
+static double distance_generic(const double* v1, const double* v2, const size_t n) {
+  double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const double d0 = v1[i] - v2[i], d1 = v1[i + 1] - v2[i + 1];
+    const double d2 = v1[i + 2] - v2[i + 2], d3 = v1[i + 3] - v2[i + 3];
+    s0 += d0 * d0;
+    s1 += d1 * d1;
+    s2 += d2 * d2;
+    s3 += d3 * d3;
+  }
+  for (; i < n; i++)
+    s0 += (v1[i] - v2[i]) * (v1[i] - v2[i]);
+  return (s0 + s1) + (s2 + s3);
+}
+
+#if VECTOR_X86
+
+// SSE2: FOUR 2-WIDE ACCUMULATORS
+
+__attribute__((target("sse2"))) static double sse2_sum(const __m128d a, const __m128d b, const __m128d c, const __m128d d) {
+  const __m128d s = _mm_add_pd(_mm_add_pd(a, b), _mm_add_pd(c, d));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+__attribute__((target("sse2"))) static double dot_sse2(const double* v1, const double* v2, const size_t n) {
+  __m128d s0 = _mm_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(v1 + i), _mm_loadu_pd(v2 + i)));
+    s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(v1 + i + 2), _mm_loadu_pd(v2 + i + 2)));
+    s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(v1 + i + 4), _mm_loadu_pd(v2 + i + 4)));
+    s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(v1 + i + 6), _mm_loadu_pd(v2 + i + 6)));
+  }
+  double s = sse2_sum(s0, s1, s2, s3);
+  for (; i < n; i++)
+    s += v1[i] * v2[i];
+  return s;
+}
+
+__attribute__((target("sse2"))) static double distance_sse2(const double* v1, const double* v2, const size_t n) {
+  __m128d s0 = _mm_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m128d d0 = _mm_sub_pd(_mm_loadu_pd(v1 + i), _mm_loadu_pd(v2 + i));
+    const __m128d d1 = _mm_sub_pd(_mm_loadu_pd(v1 + i + 2), _mm_loadu_pd(v2 + i + 2));
+    const __m128d d2 = _mm_sub_pd(_mm_loadu_pd(v1 + i + 4), _mm_loadu_pd(v2 + i + 4));
+    const __m128d d3 = _mm_sub_pd(_mm_loadu_pd(v1 + i + 6), _mm_loadu_pd(v2 + i + 6));
+    s0 = _mm_add_pd(s0, _mm_mul_pd(d0, d0));
+    s1 = _mm_add_pd(s1, _mm_mul_pd(d1, d1));
+    s2 = _mm_add_pd(s2, _mm_mul_pd(d2, d2));
+    s3 = _mm_add_pd(s3, _mm_mul_pd(d3, d3));
+  }
+  double s = sse2_sum(s0, s1, s2, s3);
+  for (; i < n; i++)
+    s += (v1[i] - v2[i]) * (v1[i] - v2[i]);
+  return s;
+}
+
+// AVX2 + FMA: FOUR 4-WIDE FUSED ACCUMULATORS
+
+__attribute__((target("avx2,fma"))) static double avx2_sum(const __m256d a, const __m256d b, const __m256d c, const __m256d d) {
+  const __m256d s = _mm256_add_pd(_mm256_add_pd(a, b), _mm256_add_pd(c, d));
+  const __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+}
+
+__attribute__((target("avx2,fma"))) static double dot_avx2(const double* v1, const double* v2, const size_t n) {
+  __m256d s0 = _mm256_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(v1 + i), _mm256_loadu_pd(v2 + i), s0);
+    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(v1 + i + 4), _mm256_loadu_pd(v2 + i + 4), s1);
+    s2 = _mm256_fmadd_pd(_mm256_loadu_pd(v1 + i + 8), _mm256_loadu_pd(v2 + i + 8), s2);
+    s3 = _mm256_fmadd_pd(_mm256_loadu_pd(v1 + i + 12), _mm256_loadu_pd(v2 + i + 12), s3);
+  }
+  double s = avx2_sum(s0, s1, s2, s3);
+  for (; i < n; i++)
+    s += v1[i] * v2[i];
+  return s;
+}
+
+__attribute__((target("avx2,fma"))) static double distance_avx2(const double* v1, const double* v2, const size_t n) {
+  __m256d s0 = _mm256_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(v1 + i), _mm256_loadu_pd(v2 + i));
+    const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(v1 + i + 4), _mm256_loadu_pd(v2 + i + 4));
+    const __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(v1 + i + 8), _mm256_loadu_pd(v2 + i + 8));
+    const __m256d d3 = _mm256_sub_pd(_mm256_loadu_pd(v1 + i + 12), _mm256_loadu_pd(v2 + i + 12));
+    s0 = _mm256_fmadd_pd(d0, d0, s0);
+    s1 = _mm256_fmadd_pd(d1, d1, s1);
+    s2 = _mm256_fmadd_pd(d2, d2, s2);
+    s3 = _mm256_fmadd_pd(d3, d3, s3);
+  }
+  double s = avx2_sum(s0, s1, s2, s3);
+  for (; i < n; i++)
+    s += (v1[i] - v2[i]) * (v1[i] - v2[i]);
+  return s;
+}
+
+// AVX-512: FOUR 8-WIDE FUSED ACCUMULATORS, WITH A MASKED LOAD FOR THE TAIL
+
+__attribute__((target("avx512f"))) static double dot_avx512(const double* v1, const double* v2, const size_t n) {
+  __m512d s0 = _mm512_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(v1 + i), _mm512_loadu_pd(v2 + i), s0);
+    s1 = _mm512_fmadd_pd(_mm512_loadu_pd(v1 + i + 8), _mm512_loadu_pd(v2 + i + 8), s1);
+    s2 = _mm512_fmadd_pd(_mm512_loadu_pd(v1 + i + 16), _mm512_loadu_pd(v2 + i + 16), s2);
+    s3 = _mm512_fmadd_pd(_mm512_loadu_pd(v1 + i + 24), _mm512_loadu_pd(v2 + i + 24), s3);
+  }
+  for (; i < n; i += 8) {
+    const __mmask8 mask = (n - i >= 8) ? 0xff : (__mmask8) ((1u << (n - i)) - 1);
+    s0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, v1 + i), _mm512_maskz_loadu_pd(mask, v2 + i), s0);
+  }
+  return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+__attribute__((target("avx512f"))) static double distance_avx512(const double* v1, const double* v2, const size_t n) {
+  __m512d s0 = _mm512_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(v1 + i), _mm512_loadu_pd(v2 + i));
+    const __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(v1 + i + 8), _mm512_loadu_pd(v2 + i + 8));
+    const __m512d d2 = _mm512_sub_pd(_mm512_loadu_pd(v1 + i + 16), _mm512_loadu_pd(v2 + i + 16));
+    const __m512d d3 = _mm512_sub_pd(_mm512_loadu_pd(v1 + i + 24), _mm512_loadu_pd(v2 + i + 24));
+    s0 = _mm512_fmadd_pd(d0, d0, s0);
+    s1 = _mm512_fmadd_pd(d1, d1, s1);
+    s2 = _mm512_fmadd_pd(d2, d2, s2);
+    s3 = _mm512_fmadd_pd(d3, d3, s3);
+  }
+  for (; i < n; i += 8) {
+    const __mmask8 mask = (n - i >= 8) ? 0xff : (__mmask8) ((1u << (n - i)) - 1);
+    const __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, v1 + i), _mm512_maskz_loadu_pd(mask, v2 + i));
+    s0 = _mm512_fmadd_pd(d, d, s0);
+  }
+  return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+#endif
+
+static const vector_kernel dotKernels[] = {
+  dot_generic,
+#if VECTOR_X86
+  dot_sse2, dot_avx2, dot_avx512
+#endif
+};
+
+static const vector_kernel distanceKernels[] = {
+  distance_generic,
+#if VECTOR_X86
+  distance_sse2, distance_avx2, distance_avx512
+#endif
+};
+
+static enum VectorIsa vectorIsa = VECTOR_ISA_GENERIC;
+static vector_kernel dotKernel = dot_generic;
+static vector_kernel distanceKernel = distance_generic;
+static unsigned int vectorThreads = 1;
+
+static bool isa_supported(const enum VectorIsa isa) {
+#if VECTOR_X86
+  __builtin_cpu_init();
+  switch (isa) {
+    case VECTOR_ISA_GENERIC:
+      return true;
+    case VECTOR_ISA_SSE2:
+      return __builtin_cpu_supports("sse2");
+    case VECTOR_ISA_AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case VECTOR_ISA_AVX512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+#else
+  return isa == VECTOR_ISA_GENERIC;
+#endif
+}
+
+bool set_vector_isa(const enum VectorIsa isa) {
+  if (!isa_supported(isa))
+    return false;
+  vectorIsa = isa;
+  dotKernel = dotKernels[isa];
+  distanceKernel = distanceKernels[isa];
+  return true;
+}
+
+// RUNS ONCE, BEFORE main
+__attribute__((constructor)) static void select_vector_isa(void) {
+  for (int isa = VECTOR_ISA_AVX512; isa > VECTOR_ISA_GENERIC; isa--) {
+    if (set_vector_isa(isa))
+      return;
+  }
+}
+
+enum VectorIsa get_vector_isa(void) {
+  return vectorIsa;
+}
+
+const char* vector_isa_name(const enum VectorIsa isa) {
+  switch (isa) {
+    case VECTOR_ISA_GENERIC:
+      return "generic";
+    case VECTOR_ISA_SSE2:
+      return "sse2";
+    case VECTOR_ISA_AVX2:
+      return "avx2";
+    case VECTOR_ISA_AVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+void set_vector_threads(const unsigned int nthreads) {
+  vectorThreads = nthreads;
+}
+
+unsigned int get_vector_threads(void) {
+  return vectorThreads ? vectorThreads : get_matrix_threads();
+}
+
+// BLOCKED REDUCTION FOR LARGE VECTORS: THREAD t FILLS partials[b] FOR b = t, t + nthreads, ...
+struct ReductionTask {
+  vector_kernel kernel;
+  const double* v1;
+  const double* v2;
+  size_t n;
+  double* partials;
+  size_t first;
+  size_t stride;
+};
+
+static void* reduction_thread(void* ptr) {
+  const struct ReductionTask* task = ptr;
+  const size_t nblocks = (task->n + VECTOR_REDUCTION_BLOCK - 1) / VECTOR_REDUCTION_BLOCK;
+  for (size_t b = task->first; b < nblocks; b += task->stride) {
+    const size_t start = b * VECTOR_REDUCTION_BLOCK;
+    const size_t length = (task->n - start < VECTOR_REDUCTION_BLOCK) ? task->n - start : VECTOR_REDUCTION_BLOCK;
+    task->partials[b] = task->kernel(task->v1 + start, task->v2 + start, length);
+  }
+  return NULL;
+}
+
+static double reduce(const vector_kernel kernel, const double* v1, const double* v2, const size_t n) {
+  if (n < VECTOR_THREAD_THRESHOLD)
+    return kernel(v1, v2, n);
+  const size_t nblocks = (n + VECTOR_REDUCTION_BLOCK - 1) / VECTOR_REDUCTION_BLOCK;
+  unsigned int nthreads = get_vector_threads();
+  if (nthreads > nblocks)
+    nthreads = (unsigned int) nblocks;
+  // ONE PARTIAL PER BLOCK: UP TO 2 MiB FOR THE LARGEST dim, SO NOT ON THE STACK
+  double* partials = malloc(nblocks * sizeof(double));
+  if (!partials)
+    return kernel(v1, v2, n);
+  struct ReductionTask tasks[nthreads];
+  pthread_t threads[nthreads];
+  for (unsigned int t = 0; t < nthreads; t++) {
+    const struct ReductionTask task = { kernel, v1, v2, n, partials, t, nthreads };
+    tasks[t] = task;
+  }
+  unsigned int t = 1;
+  for (; t < nthreads; t++) {
+    if (pthread_create(&threads[t], NULL, reduction_thread, &tasks[t]))
+      break;
+  }
+  reduction_thread(&tasks[0]);
+  for (unsigned int u = 1; u < t; u++)
+    pthread_join(threads[u], NULL);
+  for (; t < nthreads; t++)
+    reduction_thread(&tasks[t]);
+  // THE PARTIALS ARE ADDED IN BLOCK ORDER, WHATEVER THE THREAD COUNT
+  double sum = 0;
+  for (size_t b = 0; b < nblocks; b++)
+    sum += partials[b];
+  free(partials);
+  return sum;
+}
+
+double inner_product(const double* v1, const double* v2, const unsigned int dim) {
+  return reduce(dotKernel, v1, v2, dim);
+}
+
+double difference_norm(const double* v1, const double* v2, const unsigned int dim) {
+  return sqrt(reduce(distanceKernel, v1, v2, dim));
+}
+
+double difference_norm_bounded(const double* v1, const double* v2, const unsigned int dim, const double bound) {
+  const double limit = bound * bound;
+  double sum = 0;
+  for (size_t start = 0; start < dim; start += VECTOR_EARLY_EXIT_CHUNK) {
+    const size_t length = (dim - start < VECTOR_EARLY_EXIT_CHUNK) ? dim - start : VECTOR_EARLY_EXIT_CHUNK;
+    sum += distanceKernel(v1 + start, v2 + start, length);
+    if (sum > limit)
+      break;
+  }
+  return sqrt(sum);
+}
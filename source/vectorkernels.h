@@ -0,0 +1,45 @@
+//
+//  vectorkernels.h
+//  NummetC
+//
+//  Created by Haniel Campos Alcantara Paulo on 8/12/19.
+//  Copyright © 2019 Haniel Campos. All rights reserved.
+//
+
+#ifndef vectorkernels_h
+#define vectorkernels_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// inner_product, difference_norm AND difference_norm_bounded (definitions.h) ARE BUILT FOR
+// SEVERAL INSTRUCTION SETS AND THE BEST ONE THE CPU SUPPORTS IS PICKED ONCE AT LOAD TIME.
+// EVERY VARIANT KEEPS SEVERAL INDEPENDENT ACCUMULATORS, SO THE LAST BITS OF A SUM MAY DIFFER
+// BETWEEN VARIANTS, BUT NEVER BETWEEN RUNS ON THE SAME VARIANT
+enum VectorIsa {
+  VECTOR_ISA_GENERIC,
+  VECTOR_ISA_SSE2,
+  VECTOR_ISA_AVX2,
+  VECTOR_ISA_AVX512
+};
+
+enum VectorIsa get_vector_isa(void);
+
+const char* vector_isa_name(const enum VectorIsa isa);
+
+// FORCES A VARIANT (E.G. TO COMPARE THEM). RETURNS false, CHANGING NOTHING, IF THE CPU OR
+// THE BUILD DOES NOT SUPPORT IT
+bool set_vector_isa(const enum VectorIsa isa);
+
+// VECTORS OF AT LEAST VECTOR_THREAD_THRESHOLD ELEMENTS ARE REDUCED IN FIXED BLOCKS OF
+// VECTOR_REDUCTION_BLOCK, WHOSE PARTIAL SUMS ARE ADDED IN ORDER. THE RESULT THEREFORE DOES
+// NOT DEPEND ON HOW MANY THREADS SHARE THE BLOCKS (1 BY DEFAULT, 0 MEANS ONE PER CPU)
+#define VECTOR_THREAD_THRESHOLD (1u << 18)
+#define VECTOR_REDUCTION_BLOCK (1u << 14)
+
+void set_vector_threads(const unsigned int nthreads);
+
+unsigned int get_vector_threads(void);
+
+#endif /* vectorkernels_h */